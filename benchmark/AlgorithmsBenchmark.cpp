@@ -0,0 +1,172 @@
+#include "src/Algorithms.h"
+#include "src/Vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace SCONE
+{
+namespace Benchmark
+{
+namespace
+{
+using InstructionSet = AlgorithmsDetails::InstructionSet;
+
+template <typename VectorType>
+using ValueType = typename VectorType::value_type;
+
+// Values cycle through a small range, so that the searched value (the largest one) is only at the end.
+template <typename VectorType>
+VectorType makeVector(const size_t size)
+{
+    VectorType result;
+    result.reserve(size);
+    for (size_t i = 0U; i < size; ++i)
+    {
+        result.push_back(static_cast<ValueType<VectorType>>(i % 100U));
+    }
+    if (size)
+    {
+        result.back() = 100U;
+    }
+    return result;
+}
+
+// Second argument selects the kernels: the std algorithm or one of instruction sets.
+constexpr int64_t StdAlgorithm = -1;
+
+template <typename Function>
+void run(benchmark::State& state, Function function)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto kernels = state.range(1);
+    const auto detected = AlgorithmsDetails::getInstructionSet();
+    if (kernels != StdAlgorithm && !AlgorithmsDetails::setInstructionSet(static_cast<InstructionSet>(kernels)))
+    {
+        state.SkipWithError("Instruction set isn't supported");
+        return;
+    }
+
+    function(size, kernels == StdAlgorithm);
+    AlgorithmsDetails::setInstructionSet(detected);
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename VectorType>
+void find(benchmark::State& state)
+{
+    run(state, [&state](const size_t size, const bool useStd) {
+        const auto vector = makeVector<VectorType>(size);
+        const auto value = ValueType<VectorType>(100U);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(useStd ? std::find(vector.begin(), vector.end(), value)
+                                            : SCONE::find(vector, value));
+        }
+    });
+}
+
+template <typename VectorType>
+void count(benchmark::State& state)
+{
+    run(state, [&state](const size_t size, const bool useStd) {
+        const auto vector = makeVector<VectorType>(size);
+        const auto value = ValueType<VectorType>(7U);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(useStd ? size_t(std::count(vector.begin(), vector.end(), value))
+                                            : SCONE::count(vector, value));
+        }
+    });
+}
+
+template <typename VectorType>
+void sum(benchmark::State& state)
+{
+    run(state, [&state](const size_t size, const bool useStd) {
+        const auto vector = makeVector<VectorType>(size);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(useStd ? std::accumulate(vector.begin(), vector.end(), ValueType<VectorType>())
+                                            : SCONE::sum(vector));
+        }
+    });
+}
+
+template <typename VectorType>
+void minElement(benchmark::State& state)
+{
+    run(state, [&state](const size_t size, const bool useStd) {
+        const auto vector = makeVector<VectorType>(size);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(useStd ? std::min_element(vector.begin(), vector.end())
+                                            : SCONE::minElement(vector));
+        }
+    });
+}
+
+template <typename VectorType>
+void maxElement(benchmark::State& state)
+{
+    run(state, [&state](const size_t size, const bool useStd) {
+        const auto vector = makeVector<VectorType>(size);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(useStd ? std::max_element(vector.begin(), vector.end())
+                                            : SCONE::maxElement(vector));
+        }
+    });
+}
+
+template <typename VectorType>
+void equal(benchmark::State& state)
+{
+    run(state, [&state](const size_t size, const bool useStd) {
+        const auto vector = makeVector<VectorType>(size);
+        const auto other = vector;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(useStd ? std::equal(vector.begin(), vector.end(), other.begin())
+                                            : SCONE::equal(vector, other));
+        }
+    });
+}
+
+template <typename T>
+using InlineVector8 = InlineVector<T, 8U>;
+
+#define SCONE_BENCHMARK_KERNELS(Function, VectorType)                                                     \
+    BENCHMARK_TEMPLATE(Function, VectorType)                                                             \
+        ->ArgNames({"size", "kernels"})                                                                  \
+        ->ArgsProduct({{16, 256, 4096, 65536},                                                           \
+                       {StdAlgorithm,                                                                    \
+                        int64_t(InstructionSet::Scalar),                                                 \
+                        int64_t(InstructionSet::Sse2),                                                   \
+                        int64_t(InstructionSet::Avx2)}})
+
+#define SCONE_BENCHMARK(Function)                                   \
+    SCONE_BENCHMARK_KERNELS(Function, CompactVector<int32_t>);      \
+    SCONE_BENCHMARK_KERNELS(Function, InlineVector8<uint64_t>);     \
+    SCONE_BENCHMARK_KERNELS(Function, CompactVector<uint8_t>);      \
+    SCONE_BENCHMARK_KERNELS(Function, CompactVector<float>)
+
+SCONE_BENCHMARK(find);
+SCONE_BENCHMARK(count);
+SCONE_BENCHMARK(equal);
+
+#define SCONE_BENCHMARK_REDUCTION(Function)                         \
+    SCONE_BENCHMARK_KERNELS(Function, CompactVector<int32_t>);      \
+    SCONE_BENCHMARK_KERNELS(Function, InlineVector8<uint64_t>);     \
+    SCONE_BENCHMARK_KERNELS(Function, CompactVector<uint8_t>)
+
+SCONE_BENCHMARK_REDUCTION(sum);
+SCONE_BENCHMARK_REDUCTION(minElement);
+SCONE_BENCHMARK_REDUCTION(maxElement);
+
+} // namespace
+} // namespace Benchmark
+} // namespace SCONE
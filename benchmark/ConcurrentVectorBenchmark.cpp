@@ -0,0 +1,59 @@
+#include "src/ConcurrentVector.h"
+#include "src/Vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <mutex>
+
+namespace SCONE
+{
+namespace Benchmark
+{
+namespace
+{
+// Results collected behind a lock, as done before ConcurrentVector.
+class LockedVector
+{
+public:
+    void push_back(const uint64_t value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _values.push_back(value);
+    }
+
+private:
+    std::mutex _mutex;
+    CompactVector<uint64_t> _values;
+};
+
+// Every thread pushes its own results to one shared container.
+template <typename VectorType>
+void concurrentPushBack(benchmark::State& state)
+{
+    static VectorType* results = nullptr;
+    if (state.thread_index() == 0)
+    {
+        results = new VectorType();
+    }
+
+    uint64_t value = 0U;
+    for (auto _ : state)
+    {
+        results->push_back(value++);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        delete results;
+    }
+}
+
+// Iterations are fixed, so that containers don't grow with the measurement time.
+BENCHMARK_TEMPLATE(concurrentPushBack, LockedVector)->Iterations(1 << 20)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(concurrentPushBack, ConcurrentVector<uint64_t>)->Iterations(1 << 20)->ThreadRange(1, 32)->UseRealTime();
+
+} // namespace
+} // namespace Benchmark
+} // namespace SCONE
@@ -0,0 +1,115 @@
+// Measures memory taken by 10M small CompactVectors: bytes requested from the allocator and peak RSS.
+// Every element type and allocator runs in its own process, so that peak RSS is measured independently.
+
+#include "src/PoolAllocator.h"
+#include "src/Vector.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+using namespace SCONE;
+
+size_t requestedBytes = 0U;
+
+template <typename T, template <typename> class Allocator>
+struct CountingAllocator : Allocator<T>
+{
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U, Allocator>&)
+    {
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = CountingAllocator<U, Allocator>;
+    };
+
+    T* allocate(size_t count)
+    {
+        requestedBytes += count * sizeof(T);
+        return Allocator<T>::allocate(count);
+    }
+
+    // Counts the usable size, which is kept as capacity.
+    AllocationResult<T*> allocate_at_least(size_t count)
+    {
+        const auto allocation = allocateAtLeast(static_cast<Allocator<T>&>(*this), count);
+        requestedBytes += allocation.count * sizeof(T);
+        return allocation;
+    }
+
+    void deallocate(T* ptr, size_t count)
+    {
+        requestedBytes -= count * sizeof(T);
+        Allocator<T>::deallocate(ptr, count);
+    }
+};
+
+template <typename T, template <typename> class Allocator>
+void measure(const char* name, const size_t count, const size_t maxSize)
+{
+    std::vector<CompactVector<T, CountingAllocator<T, Allocator>>> vectors(count);
+    size_t elements = 0U;
+    for (size_t i = 0U; i < count; ++i)
+    {
+        const auto size = 1U + i % maxSize;
+        for (size_t j = 0U; j < size; ++j)
+        {
+            vectors[i].push_back(static_cast<T>(j));
+        }
+        elements += size;
+    }
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("%-33s %10zu vectors %10zu elements %12zu bytes requested %10ld KiB peak RSS\n",
+                name,
+                count,
+                elements,
+                requestedBytes,
+                usage.ru_maxrss);
+}
+
+template <typename T, template <typename> class Allocator = std::allocator>
+void runInChild(const char* name, const size_t count, const size_t maxSize)
+{
+    std::fflush(stdout);
+    const auto pid = fork();
+    if (pid == 0)
+    {
+        measure<T, Allocator>(name, count, maxSize);
+        std::fflush(stdout);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000U;
+    // Vectors get from 1 to maxSize elements.
+    const size_t maxSize = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 15U;
+
+    runInChild<uint8_t>("CompactVector<uint8_t>", count, maxSize);
+    runInChild<uint16_t>("CompactVector<uint16_t>", count, maxSize);
+    runInChild<uint32_t>("CompactVector<uint32_t>", count, maxSize);
+    runInChild<uint8_t, PoolAllocator>("pooled CompactVector<uint8_t>", count, maxSize);
+    runInChild<uint16_t, PoolAllocator>("pooled CompactVector<uint16_t>", count, maxSize);
+    runInChild<uint32_t, PoolAllocator>("pooled CompactVector<uint32_t>", count, maxSize);
+    return 0;
+}
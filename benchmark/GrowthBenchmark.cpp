@@ -0,0 +1,68 @@
+// Compares growth of a large CompactVector through the copying path (std::allocator) with in-place growth
+// (MallocAllocator). Every variant runs in its own process, so that peak RSS is measured independently.
+
+#include "src/MallocAllocator.h"
+#include "src/Vector.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+using namespace SCONE;
+
+template <typename VectorType>
+void grow(const char* name, const size_t count)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    VectorType vector;
+    for (size_t i = 0U; i < count; ++i)
+    {
+        vector.push_back(i);
+    }
+
+    const auto duration = std::chrono::steady_clock::now() - start;
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("%-40s %10zu elements %8lld ms %10ld KiB peak RSS\n",
+                name,
+                vector.size(),
+                static_cast<long long>(ms),
+                usage.ru_maxrss);
+}
+
+template <typename VectorType>
+void runInChild(const char* name, const size_t count)
+{
+    std::fflush(stdout);
+    const auto pid = fork();
+    if (pid == 0)
+    {
+        grow<VectorType>(name, count);
+        std::fflush(stdout);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // 256 MiB of uint64_t by default.
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (size_t(1U) << 25U);
+
+    runInChild<CompactVector<uint64_t>>("CompactVector<uint64_t>", count);
+    runInChild<CompactVector<uint64_t, MallocAllocator<uint64_t>>>("CompactVector<uint64_t, MallocAllocator>", count);
+    return 0;
+}
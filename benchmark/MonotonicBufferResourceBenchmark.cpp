@@ -0,0 +1,64 @@
+#include "src/MonotonicBufferResource.h"
+#include "src/Vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace SCONE
+{
+namespace Benchmark
+{
+namespace
+{
+constexpr size_t VectorsPerRequest = 200U;
+
+// One request builds short-lived vectors, most of which spill to the heap, and destroys them together.
+template <typename VectorType, typename Allocator>
+void handleRequest(std::vector<VectorType>& vectors, const Allocator& allocator, const size_t maxSize)
+{
+    for (size_t i = 0U; i < VectorsPerRequest; ++i)
+    {
+        vectors.emplace_back(allocator);
+        for (size_t j = 0U; j < i % maxSize; ++j)
+        {
+            vectors.back().push_back(static_cast<int>(j));
+        }
+    }
+    benchmark::DoNotOptimize(vectors.data());
+    vectors.clear();
+}
+
+void inlineVectors(benchmark::State& state)
+{
+    const auto maxSize = static_cast<size_t>(state.range(0));
+    std::vector<InlineVector<int, 4U>> vectors;
+    vectors.reserve(VectorsPerRequest);
+    for (auto _ : state)
+    {
+        handleRequest(vectors, std::allocator<int>(), maxSize);
+    }
+    state.SetItemsProcessed(state.iterations() * VectorsPerRequest);
+}
+
+void arenaInlineVectors(benchmark::State& state)
+{
+    const auto maxSize = static_cast<size_t>(state.range(0));
+    std::vector<pmr::InlineVector<int, 4U>> vectors;
+    vectors.reserve(VectorsPerRequest);
+    char buffer[16U * 1024U];
+    MonotonicBufferResource resource(buffer, sizeof(buffer));
+    for (auto _ : state)
+    {
+        handleRequest(vectors, PolymorphicAllocator<int>(&resource), maxSize);
+        resource.release();
+    }
+    state.SetItemsProcessed(state.iterations() * VectorsPerRequest);
+}
+
+BENCHMARK(inlineVectors)->Arg(8)->Arg(32);
+BENCHMARK(arenaInlineVectors)->Arg(8)->Arg(32);
+
+} // namespace
+} // namespace Benchmark
+} // namespace SCONE
@@ -0,0 +1,77 @@
+#include "src/PoolAllocator.h"
+#include "src/Vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SCONE
+{
+namespace Benchmark
+{
+namespace
+{
+// Builds and destroys many small vectors, like rows of an adjacency list.
+template <typename VectorType>
+void buildSmallVectors(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const size_t maxSize = 15U;
+    for (auto _ : state)
+    {
+        std::vector<VectorType> vectors(count);
+        for (size_t i = 0U; i < count; ++i)
+        {
+            for (size_t j = 0U; j <= i % maxSize; ++j)
+            {
+                vectors[i].push_back(static_cast<typename VectorType::value_type>(j));
+            }
+        }
+        benchmark::DoNotOptimize(vectors.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// Allocates and deallocates blocks in a steady state, as a long-living structure which keeps changing.
+template <typename Allocator>
+void allocateDeallocate(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    Allocator allocator;
+    std::vector<typename Allocator::value_type*> blocks(count);
+    for (size_t i = 0U; i < count; ++i)
+    {
+        blocks[i] = allocator.allocate(1U + i % 15U);
+    }
+
+    size_t i = 0U;
+    for (auto _ : state)
+    {
+        allocator.deallocate(blocks[i], 1U + i % 15U);
+        blocks[i] = allocator.allocate(1U + i % 15U);
+        benchmark::DoNotOptimize(blocks[i]);
+        i = i + 1U < count ? i + 1U : 0U;
+    }
+
+    for (size_t j = 0U; j < count; ++j)
+    {
+        allocator.deallocate(blocks[j], 1U + j % 15U);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(buildSmallVectors, CompactVector<uint32_t>)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(buildSmallVectors, CompactVector<uint32_t, PoolAllocator<uint32_t>>)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(buildSmallVectors, CompactVector<uint32_t>)->Arg(1 << 16)->Threads(4);
+BENCHMARK_TEMPLATE(buildSmallVectors, CompactVector<uint32_t, PoolAllocator<uint32_t>>)->Arg(1 << 16)->Threads(4);
+
+BENCHMARK_TEMPLATE(allocateDeallocate, std::allocator<uint32_t>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(allocateDeallocate, PoolAllocator<uint32_t>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(allocateDeallocate, std::allocator<uint32_t>)->Arg(1 << 16)->Threads(4);
+BENCHMARK_TEMPLATE(allocateDeallocate, PoolAllocator<uint32_t>)->Arg(1 << 16)->Threads(4);
+
+} // namespace
+} // namespace Benchmark
+} // namespace SCONE
@@ -0,0 +1,89 @@
+#include "src/Ring.h"
+#include "src/Vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace SCONE
+{
+namespace Benchmark
+{
+namespace
+{
+template <typename T>
+void popFront(std::deque<T>& queue)
+{
+    queue.pop_front();
+}
+
+template <typename StorageType>
+void popFront(Ring<StorageType>& queue)
+{
+    queue.pop_front();
+}
+
+// Vector based queue moves all elements on every pop.
+template <typename StorageType, typename GrowthPolicy>
+void popFront(Vector<StorageType, GrowthPolicy>& queue)
+{
+    queue.erase(queue.begin());
+}
+
+// Queue which is filled and drained at the same rate, e.g. a work queue.
+template <typename QueueType>
+void steadyQueue(benchmark::State& state)
+{
+    const auto size = static_cast<uint64_t>(state.range(0));
+    QueueType queue;
+    for (uint64_t i = 0U; i < size; ++i)
+    {
+        queue.push_back(i);
+    }
+
+    uint64_t next = size;
+    for (auto _ : state)
+    {
+        queue.push_back(next++);
+        benchmark::DoNotOptimize(queue.front());
+        popFront(queue);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Batches of elements are drained from the ring by copying its spans.
+void drainSpans(benchmark::State& state)
+{
+    const auto batch = static_cast<size_t>(state.range(0));
+    CompactDeque<uint64_t> queue;
+    std::vector<uint64_t> output(batch);
+    uint64_t next = 0U;
+    for (auto _ : state)
+    {
+        for (size_t i = 0U; i < batch; ++i)
+        {
+            queue.push_back(next++);
+        }
+
+        const auto parts = queue.span();
+        std::memcpy(output.data(), parts.first.data(), parts.first.size() * sizeof(uint64_t));
+        std::memcpy(output.data() + parts.first.size(), parts.second.data(), parts.second.size() * sizeof(uint64_t));
+        queue.pop_front(queue.size());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK_TEMPLATE(steadyQueue, std::deque<uint64_t>)->Arg(4)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(steadyQueue, InlineVector<uint64_t, 4U>)->Arg(4)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(steadyQueue, CompactDeque<uint64_t>)->Arg(4)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(steadyQueue, InlineRing<uint64_t, 4U>)->Arg(4)->Arg(64)->Arg(1024);
+
+BENCHMARK(drainSpans)->Arg(64)->Arg(1024);
+
+} // namespace
+} // namespace Benchmark
+} // namespace SCONE
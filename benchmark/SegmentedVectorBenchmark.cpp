@@ -0,0 +1,100 @@
+#include "src/Algorithms.h"
+#include "src/SegmentedVector.h"
+#include "src/Vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace SCONE
+{
+namespace Benchmark
+{
+namespace
+{
+// Large record of an append-only log.
+struct LogRecord
+{
+    uint64_t timestamp;
+    uint64_t values[15];
+};
+
+template <typename VectorType>
+void appendRecords(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        VectorType records;
+        for (size_t i = 0U; i < size; ++i)
+        {
+            records.push_back(LogRecord{i, {}});
+        }
+        benchmark::DoNotOptimize(&records.back());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename VectorType>
+VectorType makeValues(const size_t size)
+{
+    VectorType values;
+    for (size_t i = 0U; i < size; ++i)
+    {
+        values.push_back(static_cast<uint32_t>(i % 100U));
+    }
+    return values;
+}
+
+void countContiguous(benchmark::State& state)
+{
+    const auto values = makeValues<CompactVector<uint32_t>>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(SCONE::count(values, 7U));
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void countSegments(benchmark::State& state)
+{
+    const auto values = makeValues<SegmentedVector<uint32_t>>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t result = 0U;
+        values.for_each_segment([&result](const SegmentedVector<uint32_t>::const_segment& segment) {
+            result += SCONE::count(segment, 7U);
+            return true;
+        });
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void countByIndex(benchmark::State& state)
+{
+    const auto values = makeValues<SegmentedVector<uint32_t>>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t result = 0U;
+        for (size_t i = 0U; i < values.size(); ++i)
+        {
+            result += values[i] == 7U;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+BENCHMARK_TEMPLATE(appendRecords, std::vector<LogRecord>)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(appendRecords, CompactVector<LogRecord>)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(appendRecords, SegmentedVector<LogRecord>)->Arg(1 << 10)->Arg(1 << 16);
+
+BENCHMARK(countContiguous)->Arg(1 << 16);
+BENCHMARK(countSegments)->Arg(1 << 16);
+BENCHMARK(countByIndex)->Arg(1 << 16);
+
+} // namespace
+} // namespace Benchmark
+} // namespace SCONE
@@ -0,0 +1,236 @@
+#include "src/Vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SCONE
+{
+namespace Benchmark
+{
+namespace
+{
+struct Record
+{
+    uint64_t id;
+    uint64_t values[3];
+};
+
+template <typename T>
+struct ValueFactory;
+
+template <>
+struct ValueFactory<int>
+{
+    static int make(const size_t i)
+    {
+        return static_cast<int>(i);
+    }
+};
+
+template <>
+struct ValueFactory<Record>
+{
+    static Record make(const size_t i)
+    {
+        return {i, {i, i, i}};
+    }
+};
+
+template <>
+struct ValueFactory<std::string>
+{
+    // Long enough to not fit into the small string buffer.
+    static std::string make(const size_t i)
+    {
+        return "benchmark string value #" + std::to_string(i);
+    }
+};
+
+template <typename VectorType>
+using ValueType = typename VectorType::value_type;
+
+template <typename VectorType>
+ValueType<VectorType> makeValue(const size_t i)
+{
+    return ValueFactory<ValueType<VectorType>>::make(i);
+}
+
+template <typename VectorType>
+VectorType makeVector(const size_t size)
+{
+    VectorType result;
+    result.reserve(size);
+    for (size_t i = 0U; i < size; ++i)
+    {
+        result.push_back(makeValue<VectorType>(i));
+    }
+    return result;
+}
+
+template <typename VectorType>
+void pushBack(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto value = makeValue<VectorType>(0U);
+    for (auto _ : state)
+    {
+        VectorType vector;
+        for (size_t i = 0U; i < size; ++i)
+        {
+            vector.push_back(value);
+        }
+        benchmark::DoNotOptimize(vector.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename VectorType>
+void reserveFill(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto value = makeValue<VectorType>(0U);
+    for (auto _ : state)
+    {
+        VectorType vector;
+        vector.reserve(size);
+        for (size_t i = 0U; i < size; ++i)
+        {
+            vector.push_back(value);
+        }
+        benchmark::DoNotOptimize(vector.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename VectorType>
+void insertErase(benchmark::State& state, const size_t position)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto vector = makeVector<VectorType>(size);
+    const auto value = makeValue<VectorType>(size);
+    for (auto _ : state)
+    {
+        const auto pos = std::min(position, vector.size());
+        vector.insert(vector.begin() + pos, value);
+        vector.erase(vector.begin() + pos);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template <typename VectorType>
+void insertEraseFront(benchmark::State& state)
+{
+    insertErase<VectorType>(state, 0U);
+}
+
+template <typename VectorType>
+void insertEraseMiddle(benchmark::State& state)
+{
+    insertErase<VectorType>(state, static_cast<size_t>(state.range(0)) / 2U);
+}
+
+template <typename VectorType>
+void insertRange(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto source = makeVector<std::vector<ValueType<VectorType>>>(size);
+    for (auto _ : state)
+    {
+        auto vector = makeVector<VectorType>(size);
+        vector.insert(vector.begin() + size / 2U, source.begin(), source.end());
+        benchmark::DoNotOptimize(vector.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename VectorType>
+void iterate(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto vector = makeVector<VectorType>(size);
+    for (auto _ : state)
+    {
+        for (const auto& item : vector)
+        {
+            benchmark::DoNotOptimize(&item);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename VectorType>
+void copyConstruct(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto vector = makeVector<VectorType>(size);
+    for (auto _ : state)
+    {
+        const VectorType copy(vector);
+        benchmark::DoNotOptimize(copy.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename VectorType>
+void moveConstruct(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto vector = makeVector<VectorType>(size);
+    for (auto _ : state)
+    {
+        VectorType moved(std::move(vector));
+        vector = std::move(moved);
+        benchmark::DoNotOptimize(vector.begin());
+    }
+}
+
+template <typename VectorType>
+void swapVectors(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    auto vector = makeVector<VectorType>(size);
+    auto other = makeVector<VectorType>(size / 2U);
+    for (auto _ : state)
+    {
+        vector.swap(other);
+        benchmark::DoNotOptimize(vector.begin());
+    }
+}
+
+// Sizes cover inline, small heap and large heap buffers.
+#define SCONE_BENCHMARK_CONTAINER(Function, VectorType) \
+    BENCHMARK_TEMPLATE(Function, VectorType)->Arg(4)->Arg(64)->Arg(4096)
+
+template <typename T>
+using InlineVector8 = InlineVector<T, 8U>;
+
+#define SCONE_BENCHMARK_ELEMENT(Function, T)               \
+    SCONE_BENCHMARK_CONTAINER(Function, std::vector<T>);   \
+    SCONE_BENCHMARK_CONTAINER(Function, CompactVector<T>); \
+    SCONE_BENCHMARK_CONTAINER(Function, InlineVector8<T>); \
+    SCONE_BENCHMARK_CONTAINER(Function, TaggedVector<T>);  \
+    SCONE_BENCHMARK_CONTAINER(Function, SharedCompactVector<T>)
+
+#define SCONE_BENCHMARK(Function)                    \
+    SCONE_BENCHMARK_ELEMENT(Function, int);          \
+    SCONE_BENCHMARK_ELEMENT(Function, Record);       \
+    SCONE_BENCHMARK_ELEMENT(Function, std::string)
+
+SCONE_BENCHMARK(pushBack);
+SCONE_BENCHMARK(reserveFill);
+SCONE_BENCHMARK(insertEraseFront);
+SCONE_BENCHMARK(insertEraseMiddle);
+SCONE_BENCHMARK(insertRange);
+SCONE_BENCHMARK(iterate);
+SCONE_BENCHMARK(copyConstruct);
+SCONE_BENCHMARK(moveConstruct);
+SCONE_BENCHMARK(swapVectors);
+
+} // namespace
+} // namespace Benchmark
+} // namespace SCONE
@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool hasArgument(int argc, char** argv, const char* name)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], name, std::strlen(name)) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+// Results are written to benchmarks.json by default, so that runs of different versions can be diffed.
+// Both defaults can be overridden by the usual --benchmark_out and --benchmark_out_format arguments.
+int main(int argc, char** argv)
+{
+    std::vector<std::string> defaults;
+    if (!hasArgument(argc, argv, "--benchmark_out="))
+    {
+        defaults.emplace_back("--benchmark_out=benchmarks.json");
+    }
+    if (!hasArgument(argc, argv, "--benchmark_out_format="))
+    {
+        defaults.emplace_back("--benchmark_out_format=json");
+    }
+
+    std::vector<char*> arguments(argv, argv + argc);
+    for (auto& argument : defaults)
+    {
+        arguments.push_back(&argument[0]);
+    }
+    int count = static_cast<int>(arguments.size());
+
+    ::benchmark::Initialize(&count, arguments.data());
+    if (::benchmark::ReportUnrecognizedArguments(count, arguments.data()))
+    {
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
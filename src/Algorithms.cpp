@@ -0,0 +1,150 @@
+#include "Algorithms.h"
+
+#include "AlgorithmsKernels.h"
+
+#include <cassert>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SCONE_ALGORITHMS_X86_64
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#endif
+
+namespace SCONE
+{
+namespace AlgorithmsDetails
+{
+namespace Scalar
+{
+template <typename T>
+const Kernels<T>& getKernels()
+{
+    static const auto kernels = makeKernels<ScalarOps<T>>();
+    return kernels;
+}
+} // namespace Scalar
+
+namespace
+{
+#if defined(SCONE_ALGORITHMS_X86_64)
+bool hasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    // The OS has to save YMM registers as well.
+    __cpuid(info, 1);
+    const bool hasOsSupport = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6U) == 6U;
+    __cpuidex(info, 7, 0);
+    return hasOsSupport && (info[1] & (1 << 5));
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+InstructionSet detectInstructionSet()
+{
+#if defined(SCONE_ALGORITHMS_X86_64)
+    return hasAvx2() ? InstructionSet::Avx2 : InstructionSet::Sse2;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+InstructionSet& getSelectedInstructionSet()
+{
+    static auto instructionSet = detectInstructionSet();
+    return instructionSet;
+}
+
+template <typename T>
+const Kernels<T>& getKernels()
+{
+    switch (getSelectedInstructionSet())
+    {
+#if defined(SCONE_ALGORITHMS_X86_64)
+    case InstructionSet::Avx2:
+        return Avx2::getKernels<T>();
+    case InstructionSet::Sse2:
+        return Sse2::getKernels<T>();
+#endif
+    default:
+        return Scalar::getKernels<T>();
+    }
+}
+} // namespace
+
+InstructionSet getInstructionSet()
+{
+    return getSelectedInstructionSet();
+}
+
+bool setInstructionSet(const InstructionSet instructionSet)
+{
+    if (instructionSet > detectInstructionSet())
+    {
+        return false;
+    }
+    getSelectedInstructionSet() = instructionSet;
+    return true;
+}
+
+template <typename T>
+size_t KernelDispatch<T>::find(const T* data, const size_t size, const T value)
+{
+    return getKernels<T>().find(data, size, value);
+}
+
+template <typename T>
+size_t KernelDispatch<T>::count(const T* data, const size_t size, const T value)
+{
+    return getKernels<T>().count(data, size, value);
+}
+
+template <typename T>
+bool KernelDispatch<T>::equal(const T* data, const T* other, const size_t size)
+{
+    assert(getKernels<T>().equal);
+    return getKernels<T>().equal(data, other, size);
+}
+
+template <typename T>
+T KernelDispatch<T>::sum(const T* data, const size_t size)
+{
+    assert(getKernels<T>().sum);
+    return getKernels<T>().sum(data, size);
+}
+
+template <typename T>
+size_t KernelDispatch<T>::minElement(const T* data, const size_t size)
+{
+    assert(getKernels<T>().minElement);
+    return getKernels<T>().minElement(data, size);
+}
+
+template <typename T>
+size_t KernelDispatch<T>::maxElement(const T* data, const size_t size)
+{
+    assert(getKernels<T>().maxElement);
+    return getKernels<T>().maxElement(data, size);
+}
+
+template struct KernelDispatch<int8_t>;
+template struct KernelDispatch<uint8_t>;
+template struct KernelDispatch<int16_t>;
+template struct KernelDispatch<uint16_t>;
+template struct KernelDispatch<int32_t>;
+template struct KernelDispatch<uint32_t>;
+template struct KernelDispatch<int64_t>;
+template struct KernelDispatch<uint64_t>;
+template struct KernelDispatch<float>;
+template struct KernelDispatch<double>;
+} // namespace AlgorithmsDetails
+} // namespace SCONE
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+
+namespace SCONE
+{
+namespace AlgorithmsDetails
+{
+enum class InstructionSet : uint8_t
+{
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// Kernels are chosen by the instruction set detected on first use. It can be lowered, e.g. to test every
+// kernel on one machine; returns false if the requested set isn't supported by the CPU.
+InstructionSet getInstructionSet();
+bool setInstructionSet(InstructionSet instructionSet);
+
+// Entry points compiled once per fixed-width type, see Algorithms.cpp.
+template <typename T>
+struct KernelDispatch
+{
+    static size_t find(const T* data, size_t size, T value);
+    static size_t count(const T* data, size_t size, T value);
+    static bool equal(const T* data, const T* other, size_t size);
+    static T sum(const T* data, size_t size);
+    static size_t minElement(const T* data, size_t size);
+    static size_t maxElement(const T* data, size_t size);
+};
+
+template <size_t Size>
+struct IntegerOfSize
+{
+    using Signed = void;
+    using Unsigned = void;
+};
+
+template <>
+struct IntegerOfSize<1U>
+{
+    using Signed = int8_t;
+    using Unsigned = uint8_t;
+};
+
+template <>
+struct IntegerOfSize<2U>
+{
+    using Signed = int16_t;
+    using Unsigned = uint16_t;
+};
+
+template <>
+struct IntegerOfSize<4U>
+{
+    using Signed = int32_t;
+    using Unsigned = uint32_t;
+};
+
+template <>
+struct IntegerOfSize<8U>
+{
+    using Signed = int64_t;
+    using Unsigned = uint64_t;
+};
+
+// Fixed-width type with the same representation and comparison as "T", or void if there are no kernels for "T".
+template <typename T, bool Integral = std::is_integral<T>::value && !std::is_same<T, bool>::value>
+struct KernelType
+{
+    using type = std::conditional_t<std::is_same<T, float>::value || std::is_same<T, double>::value, T, void>;
+};
+
+template <typename T>
+struct KernelType<T, true>
+{
+    using type = std::conditional_t<std::is_signed<T>::value,
+                                    typename IntegerOfSize<sizeof(T)>::Signed,
+                                    typename IntegerOfSize<sizeof(T)>::Unsigned>;
+};
+
+template <typename T>
+using KernelTypeT = typename KernelType<std::remove_cv_t<T>>::type;
+
+template <typename T>
+using HasKernels = std::integral_constant<bool, !std::is_void<KernelTypeT<T>>::value>;
+
+template <typename T>
+using HasEqualKernels = std::integral_constant<bool, HasKernels<T>::value && std::is_floating_point<T>::value>;
+
+template <typename T>
+using HasReductionKernels = std::integral_constant<bool, HasKernels<T>::value && std::is_integral<T>::value>;
+
+template <typename T>
+const KernelTypeT<T>* asKernelData(const T* data)
+{
+    return reinterpret_cast<const KernelTypeT<T>*>(data);
+}
+
+template <typename T>
+size_t find(const T* data, const size_t size, const T& value, std::true_type /*hasKernels*/)
+{
+    return KernelDispatch<KernelTypeT<T>>::find(asKernelData(data), size, static_cast<KernelTypeT<T>>(value));
+}
+
+template <typename T>
+size_t find(const T* data, const size_t size, const T& value, std::false_type /*hasKernels*/)
+{
+    return static_cast<size_t>(std::find(data, data + size, value) - data);
+}
+
+template <typename T>
+size_t count(const T* data, const size_t size, const T& value, std::true_type /*hasKernels*/)
+{
+    return KernelDispatch<KernelTypeT<T>>::count(asKernelData(data), size, static_cast<KernelTypeT<T>>(value));
+}
+
+template <typename T>
+size_t count(const T* data, const size_t size, const T& value, std::false_type /*hasKernels*/)
+{
+    return static_cast<size_t>(std::count(data, data + size, value));
+}
+
+template <typename T>
+bool equal(const T* data, const T* other, const size_t size, std::true_type /*hasKernels*/)
+{
+    return KernelDispatch<KernelTypeT<T>>::equal(asKernelData(data), asKernelData(other), size);
+}
+
+template <typename T>
+bool equal(const T* data, const T* other, const size_t size, std::false_type /*hasKernels*/)
+{
+    return std::equal(data, data + size, other);
+}
+
+template <typename T>
+T sum(const T* data, const size_t size, std::true_type /*hasKernels*/)
+{
+    return static_cast<T>(KernelDispatch<KernelTypeT<T>>::sum(asKernelData(data), size));
+}
+
+template <typename T>
+T sum(const T* data, const size_t size, std::false_type /*hasKernels*/)
+{
+    return std::accumulate(data, data + size, T());
+}
+
+template <typename T>
+size_t minElement(const T* data, const size_t size, std::true_type /*hasKernels*/)
+{
+    return KernelDispatch<KernelTypeT<T>>::minElement(asKernelData(data), size);
+}
+
+template <typename T>
+size_t minElement(const T* data, const size_t size, std::false_type /*hasKernels*/)
+{
+    return static_cast<size_t>(std::min_element(data, data + size) - data);
+}
+
+template <typename T>
+size_t maxElement(const T* data, const size_t size, std::true_type /*hasKernels*/)
+{
+    return KernelDispatch<KernelTypeT<T>>::maxElement(asKernelData(data), size);
+}
+
+template <typename T>
+size_t maxElement(const T* data, const size_t size, std::false_type /*hasKernels*/)
+{
+    return static_cast<size_t>(std::max_element(data, data + size) - data);
+}
+
+template <typename Container>
+using ValueType = std::remove_cv_t<typename Container::value_type>;
+
+template <typename Container>
+auto getIterator(Container& container, const size_t index) -> decltype(container.begin())
+{
+    using Difference = typename std::iterator_traits<decltype(container.begin())>::difference_type;
+    return container.begin() + static_cast<Difference>(index);
+}
+} // namespace AlgorithmsDetails
+
+// Algorithms over contiguous containers (SCONE vectors, std::vector, ...) which use SSE2/AVX2 kernels for
+// integral and floating point elements and the std algorithms for everything else. Results match the std ones.
+
+template <typename Container>
+auto find(Container& container, const AlgorithmsDetails::ValueType<Container>& value) -> decltype(container.begin())
+{
+    using T = AlgorithmsDetails::ValueType<Container>;
+    return AlgorithmsDetails::getIterator(
+        container,
+        AlgorithmsDetails::find(container.data(), container.size(), value, AlgorithmsDetails::HasKernels<T>()));
+}
+
+template <typename Container>
+bool contains(const Container& container, const AlgorithmsDetails::ValueType<Container>& value)
+{
+    return find(container, value) != container.end();
+}
+
+template <typename Container>
+size_t count(const Container& container, const AlgorithmsDetails::ValueType<Container>& value)
+{
+    using T = AlgorithmsDetails::ValueType<Container>;
+    return AlgorithmsDetails::count(container.data(), container.size(), value, AlgorithmsDetails::HasKernels<T>());
+}
+
+template <typename Container, typename OtherContainer>
+bool equal(const Container& container, const OtherContainer& other)
+{
+    using T = AlgorithmsDetails::ValueType<Container>;
+    static_assert(std::is_same<T, AlgorithmsDetails::ValueType<OtherContainer>>::value, "Element types differ");
+    return container.size() == other.size() &&
+           AlgorithmsDetails::equal(
+               container.data(), other.data(), container.size(), AlgorithmsDetails::HasEqualKernels<T>());
+}
+
+// Sum of integers wraps around, sum of other types is accumulated in order starting from a value-initialized one.
+template <typename Container>
+AlgorithmsDetails::ValueType<Container> sum(const Container& container)
+{
+    using T = AlgorithmsDetails::ValueType<Container>;
+    return AlgorithmsDetails::sum(container.data(), container.size(), AlgorithmsDetails::HasReductionKernels<T>());
+}
+
+// Returns the first smallest element or end() if the container is empty.
+template <typename Container>
+auto minElement(Container& container) -> decltype(container.begin())
+{
+    using T = AlgorithmsDetails::ValueType<Container>;
+    return AlgorithmsDetails::getIterator(
+        container,
+        AlgorithmsDetails::minElement(container.data(), container.size(), AlgorithmsDetails::HasReductionKernels<T>()));
+}
+
+// Returns the first largest element or end() if the container is empty.
+template <typename Container>
+auto maxElement(Container& container) -> decltype(container.begin())
+{
+    using T = AlgorithmsDetails::ValueType<Container>;
+    return AlgorithmsDetails::getIterator(
+        container,
+        AlgorithmsDetails::maxElement(container.data(), container.size(), AlgorithmsDetails::HasReductionKernels<T>()));
+}
+
+} // namespace SCONE
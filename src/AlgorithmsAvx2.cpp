@@ -0,0 +1,368 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <immintrin.h>
+
+// Only code below is compiled for AVX2, standard headers above keep the baseline instruction set.
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "AlgorithmsKernels.h"
+
+namespace SCONE
+{
+namespace AlgorithmsDetails
+{
+namespace Avx2
+{
+namespace
+{
+template <size_t LaneSize>
+struct Lanes;
+
+template <>
+struct Lanes<1U>
+{
+    static __m256i broadcast(const int8_t value)
+    {
+        return _mm256_set1_epi8(value);
+    }
+
+    static __m256i equal(const __m256i a, const __m256i b)
+    {
+        return _mm256_cmpeq_epi8(a, b);
+    }
+
+    static __m256i greater(const __m256i a, const __m256i b)
+    {
+        return _mm256_cmpgt_epi8(a, b);
+    }
+
+    static __m256i add(const __m256i a, const __m256i b)
+    {
+        return _mm256_add_epi8(a, b);
+    }
+
+    static __m256i subtract(const __m256i a, const __m256i b)
+    {
+        return _mm256_sub_epi8(a, b);
+    }
+};
+
+template <>
+struct Lanes<2U>
+{
+    static __m256i broadcast(const int16_t value)
+    {
+        return _mm256_set1_epi16(value);
+    }
+
+    static __m256i equal(const __m256i a, const __m256i b)
+    {
+        return _mm256_cmpeq_epi16(a, b);
+    }
+
+    static __m256i greater(const __m256i a, const __m256i b)
+    {
+        return _mm256_cmpgt_epi16(a, b);
+    }
+
+    static __m256i add(const __m256i a, const __m256i b)
+    {
+        return _mm256_add_epi16(a, b);
+    }
+
+    static __m256i subtract(const __m256i a, const __m256i b)
+    {
+        return _mm256_sub_epi16(a, b);
+    }
+};
+
+template <>
+struct Lanes<4U>
+{
+    static __m256i broadcast(const int32_t value)
+    {
+        return _mm256_set1_epi32(value);
+    }
+
+    static __m256i equal(const __m256i a, const __m256i b)
+    {
+        return _mm256_cmpeq_epi32(a, b);
+    }
+
+    static __m256i greater(const __m256i a, const __m256i b)
+    {
+        return _mm256_cmpgt_epi32(a, b);
+    }
+
+    static __m256i add(const __m256i a, const __m256i b)
+    {
+        return _mm256_add_epi32(a, b);
+    }
+
+    static __m256i subtract(const __m256i a, const __m256i b)
+    {
+        return _mm256_sub_epi32(a, b);
+    }
+};
+
+template <>
+struct Lanes<8U>
+{
+    static __m256i broadcast(const int64_t value)
+    {
+        return _mm256_set1_epi64x(value);
+    }
+
+    static __m256i equal(const __m256i a, const __m256i b)
+    {
+        return _mm256_cmpeq_epi64(a, b);
+    }
+
+    static __m256i greater(const __m256i a, const __m256i b)
+    {
+        return _mm256_cmpgt_epi64(a, b);
+    }
+
+    static __m256i add(const __m256i a, const __m256i b)
+    {
+        return _mm256_add_epi64(a, b);
+    }
+
+    static __m256i subtract(const __m256i a, const __m256i b)
+    {
+        return _mm256_sub_epi64(a, b);
+    }
+};
+
+// Counters are unsigned lanes of "Lane" type.
+template <typename Lane>
+size_t sumLanes(const __m256i counters)
+{
+    Lane lanes[sizeof(counters) / sizeof(Lane)];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), counters);
+    size_t result = 0U;
+    for (const auto lane : lanes)
+    {
+        result += lane;
+    }
+    return result;
+}
+
+template <typename T>
+struct IntegerOps
+{
+    using value_type = T;
+    using Vector = __m256i;
+    using LanesType = Lanes<sizeof(T)>;
+
+    static constexpr size_t Width = sizeof(Vector) / sizeof(T);
+    static constexpr uint32_t FullMask = 0xFFFFFFFFU;
+
+    static Vector load(const T* ptr)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const Vector*>(ptr));
+    }
+
+    static Vector broadcast(const T value)
+    {
+        return LanesType::broadcast(static_cast<std::make_signed_t<T>>(value));
+    }
+
+    static uint32_t equalMask(const Vector a, const Vector b)
+    {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(LanesType::equal(a, b)));
+    }
+
+    using Counters = Vector;
+
+    static Counters zeroCounters()
+    {
+        return _mm256_setzero_si256();
+    }
+
+    // Matching lanes are all ones, i.e. -1.
+    static Counters countEqual(const Counters counters, const Vector a, const Vector b)
+    {
+        return LanesType::subtract(counters, LanesType::equal(a, b));
+    }
+
+    static size_t sumCounters(const Counters counters)
+    {
+        return sumLanes<std::make_unsigned_t<T>>(counters);
+    }
+
+    static Vector add(const Vector a, const Vector b)
+    {
+        return LanesType::add(a, b);
+    }
+
+    static Vector min(const Vector a, const Vector b)
+    {
+        return _mm256_blendv_epi8(a, b, greater(a, b));
+    }
+
+    static Vector max(const Vector a, const Vector b)
+    {
+        return _mm256_blendv_epi8(b, a, greater(a, b));
+    }
+
+    static void store(T* out, const Vector value)
+    {
+        _mm256_storeu_si256(reinterpret_cast<Vector*>(out), value);
+    }
+
+private:
+    static Vector greater(const Vector a, const Vector b)
+    {
+        return greater(a, b, std::is_signed<T>());
+    }
+
+    static Vector greater(const Vector a, const Vector b, std::true_type /*signed*/)
+    {
+        return LanesType::greater(a, b);
+    }
+
+    // Unsigned lanes are compared as signed ones with flipped sign bits.
+    static Vector greater(const Vector a, const Vector b, std::false_type /*signed*/)
+    {
+        const auto sign = broadcast(static_cast<T>(T(1U) << (sizeof(T) * 8U - 1U)));
+        return LanesType::greater(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+    }
+};
+
+struct FloatOps
+{
+    using value_type = float;
+    using Vector = __m256;
+
+    static constexpr size_t Width = sizeof(Vector) / sizeof(float);
+    static constexpr uint32_t FullMask = 0xFFFFFFFFU;
+
+    static Vector load(const float* ptr)
+    {
+        return _mm256_loadu_ps(ptr);
+    }
+
+    static Vector broadcast(const float value)
+    {
+        return _mm256_set1_ps(value);
+    }
+
+    static uint32_t equalMask(const Vector a, const Vector b)
+    {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))));
+    }
+
+    using Counters = __m256i;
+
+    static Counters zeroCounters()
+    {
+        return _mm256_setzero_si256();
+    }
+
+    static Counters countEqual(const Counters counters, const Vector a, const Vector b)
+    {
+        return _mm256_sub_epi32(counters, _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+    }
+
+    static size_t sumCounters(const Counters counters)
+    {
+        return sumLanes<uint32_t>(counters);
+    }
+};
+
+struct DoubleOps
+{
+    using value_type = double;
+    using Vector = __m256d;
+
+    static constexpr size_t Width = sizeof(Vector) / sizeof(double);
+    static constexpr uint32_t FullMask = 0xFFFFFFFFU;
+
+    static Vector load(const double* ptr)
+    {
+        return _mm256_loadu_pd(ptr);
+    }
+
+    static Vector broadcast(const double value)
+    {
+        return _mm256_set1_pd(value);
+    }
+
+    static uint32_t equalMask(const Vector a, const Vector b)
+    {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))));
+    }
+
+    using Counters = __m256i;
+
+    static Counters zeroCounters()
+    {
+        return _mm256_setzero_si256();
+    }
+
+    static Counters countEqual(const Counters counters, const Vector a, const Vector b)
+    {
+        return _mm256_sub_epi64(counters, _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+    }
+
+    static size_t sumCounters(const Counters counters)
+    {
+        return sumLanes<uint64_t>(counters);
+    }
+};
+
+template <typename T>
+struct Ops : IntegerOps<T>
+{
+};
+
+template <>
+struct Ops<float> : FloatOps
+{
+};
+
+template <>
+struct Ops<double> : DoubleOps
+{
+};
+} // namespace
+
+template <typename T>
+const Kernels<T>& getKernels()
+{
+    static const auto kernels = makeKernels<Ops<T>>();
+    return kernels;
+}
+
+template const Kernels<int8_t>& getKernels();
+template const Kernels<uint8_t>& getKernels();
+template const Kernels<int16_t>& getKernels();
+template const Kernels<uint16_t>& getKernels();
+template const Kernels<int32_t>& getKernels();
+template const Kernels<uint32_t>& getKernels();
+template const Kernels<int64_t>& getKernels();
+template const Kernels<uint64_t>& getKernels();
+template const Kernels<float>& getKernels();
+template const Kernels<double>& getKernels();
+} // namespace Avx2
+} // namespace AlgorithmsDetails
+} // namespace SCONE
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
@@ -0,0 +1,370 @@
+#pragma once
+
+// Internal header of Algorithms*.cpp: generic kernels written against an "Ops" type which wraps
+// vector instructions of one instruction set. Each translation unit includes it after enabling its
+// instruction set, so everything here has internal linkage to keep differently compiled copies apart.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace SCONE
+{
+namespace AlgorithmsDetails
+{
+template <typename T>
+struct Kernels
+{
+    size_t (*find)(const T* data, size_t size, T value);
+    size_t (*count)(const T* data, size_t size, T value);
+    // Integers are compared by memcmp of the C library, which already uses vector instructions.
+    bool (*equal)(const T* data, const T* other, size_t size);
+    // Floating point reductions would be reordered, so they are provided for integral types only.
+    T (*sum)(const T* data, size_t size);
+    size_t (*minElement)(const T* data, size_t size);
+    size_t (*maxElement)(const T* data, size_t size);
+};
+
+namespace Scalar
+{
+template <typename T>
+const Kernels<T>& getKernels();
+} // namespace Scalar
+
+namespace Sse2
+{
+template <typename T>
+const Kernels<T>& getKernels();
+} // namespace Sse2
+
+namespace Avx2
+{
+template <typename T>
+const Kernels<T>& getKernels();
+} // namespace Avx2
+
+namespace
+{
+// Mask has a bit per byte of a vector, so its bits are counted in bytes.
+inline uint32_t countTrailingZeros(const uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#else
+    uint32_t result = 0U;
+    for (auto rest = mask; !(rest & 1U); rest >>= 1U)
+    {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+// Elements are read through memcpy because callers pass e.g. "long long" data as int64_t.
+template <typename T>
+T loadScalar(const T* ptr)
+{
+    T result;
+    std::memcpy(&result, ptr, sizeof(T));
+    return result;
+}
+
+// Wraps around like the vector instructions do, without signed overflow.
+template <typename T>
+T addWrapping(const T a, const T b)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<Unsigned>(static_cast<Unsigned>(a) + static_cast<Unsigned>(b)));
+}
+
+template <typename T>
+struct ScalarOps
+{
+    using value_type = T;
+    using Vector = T;
+
+    static constexpr size_t Width = 1U;
+    static constexpr uint32_t FullMask = (uint32_t(1U) << sizeof(T)) - 1U;
+
+    static Vector load(const T* ptr)
+    {
+        return loadScalar(ptr);
+    }
+
+    static Vector broadcast(const T value)
+    {
+        return value;
+    }
+
+    static uint32_t equalMask(const Vector a, const Vector b)
+    {
+        return a == b ? FullMask : 0U;
+    }
+
+    using Counters = size_t;
+
+    static Counters zeroCounters()
+    {
+        return 0U;
+    }
+
+    static Counters countEqual(const Counters counters, const Vector a, const Vector b)
+    {
+        return counters + (a == b);
+    }
+
+    static size_t sumCounters(const Counters counters)
+    {
+        return counters;
+    }
+
+    static Vector add(const Vector a, const Vector b)
+    {
+        return addWrapping(a, b);
+    }
+
+    static Vector min(const Vector a, const Vector b)
+    {
+        return b < a ? b : a;
+    }
+
+    static Vector max(const Vector a, const Vector b)
+    {
+        return a < b ? b : a;
+    }
+
+    static void store(T* out, const Vector value)
+    {
+        *out = value;
+    }
+};
+
+// Main loops process Unroll vectors per iteration to keep several independent instructions in flight.
+constexpr size_t Unroll = 4U;
+
+template <typename T>
+size_t getMatchIndex(const size_t index, const uint32_t mask)
+{
+    return index + countTrailingZeros(mask) / sizeof(T);
+}
+
+template <typename Ops, typename T>
+size_t find(const T* data, const size_t size, const T value)
+{
+    constexpr auto Width = Ops::Width;
+    const auto needle = Ops::broadcast(value);
+    size_t i = 0U;
+    for (; i + Unroll * Width <= size; i += Unroll * Width)
+    {
+        const auto mask0 = Ops::equalMask(Ops::load(data + i), needle);
+        const auto mask1 = Ops::equalMask(Ops::load(data + i + Width), needle);
+        const auto mask2 = Ops::equalMask(Ops::load(data + i + 2U * Width), needle);
+        const auto mask3 = Ops::equalMask(Ops::load(data + i + 3U * Width), needle);
+        if (mask0 | mask1 | mask2 | mask3)
+        {
+            return mask0   ? getMatchIndex<T>(i, mask0)
+                   : mask1 ? getMatchIndex<T>(i + Width, mask1)
+                   : mask2 ? getMatchIndex<T>(i + 2U * Width, mask2)
+                           : getMatchIndex<T>(i + 3U * Width, mask3);
+        }
+    }
+    for (; i + Width <= size; i += Width)
+    {
+        const auto mask = Ops::equalMask(Ops::load(data + i), needle);
+        if (mask)
+        {
+            return getMatchIndex<T>(i, mask);
+        }
+    }
+    for (; i < size; ++i)
+    {
+        if (loadScalar(data + i) == value)
+        {
+            return i;
+        }
+    }
+    return size;
+}
+
+// Matches are counted in lanes of the element size, which are summed up before the narrowest ones can overflow.
+template <typename Ops, typename T>
+size_t count(const T* data, const size_t size, const T value)
+{
+    constexpr auto Width = Ops::Width;
+    constexpr size_t BlockSize = 255U * Width;
+    const auto needle = Ops::broadcast(value);
+    size_t result = 0U;
+    size_t i = 0U;
+    while (i + Width <= size)
+    {
+        const auto blockEnd = size - i > BlockSize ? i + BlockSize : size;
+        auto counters = Ops::zeroCounters();
+        for (; i + Unroll * Width <= blockEnd; i += Unroll * Width)
+        {
+            counters = Ops::countEqual(counters, Ops::load(data + i), needle);
+            counters = Ops::countEqual(counters, Ops::load(data + i + Width), needle);
+            counters = Ops::countEqual(counters, Ops::load(data + i + 2U * Width), needle);
+            counters = Ops::countEqual(counters, Ops::load(data + i + 3U * Width), needle);
+        }
+        for (; i + Width <= blockEnd; i += Width)
+        {
+            counters = Ops::countEqual(counters, Ops::load(data + i), needle);
+        }
+        result += Ops::sumCounters(counters);
+    }
+    for (; i < size; ++i)
+    {
+        result += loadScalar(data + i) == value;
+    }
+    return result;
+}
+
+// Floating point values follow operator==: NaN differs from itself, zeros of both signs are equal.
+template <typename Ops, typename T>
+bool equal(const T* data, const T* other, const size_t size)
+{
+    constexpr auto Width = Ops::Width;
+    size_t i = 0U;
+    for (; i + Unroll * Width <= size; i += Unroll * Width)
+    {
+        const auto mask0 = Ops::equalMask(Ops::load(data + i), Ops::load(other + i));
+        const auto mask1 = Ops::equalMask(Ops::load(data + i + Width), Ops::load(other + i + Width));
+        const auto mask2 = Ops::equalMask(Ops::load(data + i + 2U * Width), Ops::load(other + i + 2U * Width));
+        const auto mask3 = Ops::equalMask(Ops::load(data + i + 3U * Width), Ops::load(other + i + 3U * Width));
+        if ((mask0 & mask1 & mask2 & mask3) != Ops::FullMask)
+        {
+            return false;
+        }
+    }
+    for (; i + Width <= size; i += Width)
+    {
+        if (Ops::equalMask(Ops::load(data + i), Ops::load(other + i)) != Ops::FullMask)
+        {
+            return false;
+        }
+    }
+    for (; i < size; ++i)
+    {
+        if (!(loadScalar(data + i) == loadScalar(other + i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Ops, typename T>
+T sum(const T* data, const size_t size)
+{
+    constexpr auto Width = Ops::Width;
+    T lanes[Width] = {};
+    size_t i = 0U;
+    if (size >= Unroll * Width)
+    {
+        auto total0 = Ops::load(data);
+        auto total1 = Ops::load(data + Width);
+        auto total2 = Ops::load(data + 2U * Width);
+        auto total3 = Ops::load(data + 3U * Width);
+        for (i = Unroll * Width; i + Unroll * Width <= size; i += Unroll * Width)
+        {
+            total0 = Ops::add(total0, Ops::load(data + i));
+            total1 = Ops::add(total1, Ops::load(data + i + Width));
+            total2 = Ops::add(total2, Ops::load(data + i + 2U * Width));
+            total3 = Ops::add(total3, Ops::load(data + i + 3U * Width));
+        }
+        Ops::store(lanes, Ops::add(Ops::add(total0, total1), Ops::add(total2, total3)));
+    }
+
+    T result = 0;
+    for (const auto lane : lanes)
+    {
+        result = addWrapping(result, lane);
+    }
+    for (; i < size; ++i)
+    {
+        result = addWrapping(result, loadScalar(data + i));
+    }
+    return result;
+}
+
+template <typename Ops, bool IsMax>
+typename Ops::Vector selectExtreme(const typename Ops::Vector a, const typename Ops::Vector b)
+{
+    return IsMax ? Ops::max(a, b) : Ops::min(a, b);
+}
+
+// Finds the extreme value first and then its first position, like std::min_element does.
+// The last vector overlaps the previous ones instead of falling back to a scalar tail.
+template <typename Ops, bool IsMax, typename T>
+size_t findExtreme(const T* data, const size_t size)
+{
+    constexpr auto Width = Ops::Width;
+    if (!size)
+    {
+        return 0U;
+    }
+    if (size < Width)
+    {
+        return findExtreme<ScalarOps<T>, IsMax>(data, size);
+    }
+
+    auto extreme = Ops::load(data);
+    size_t i = Width;
+    if (size >= Unroll * Width)
+    {
+        auto extreme1 = Ops::load(data + Width);
+        auto extreme2 = Ops::load(data + 2U * Width);
+        auto extreme3 = Ops::load(data + 3U * Width);
+        for (i = Unroll * Width; i + Unroll * Width <= size; i += Unroll * Width)
+        {
+            extreme = selectExtreme<Ops, IsMax>(extreme, Ops::load(data + i));
+            extreme1 = selectExtreme<Ops, IsMax>(extreme1, Ops::load(data + i + Width));
+            extreme2 = selectExtreme<Ops, IsMax>(extreme2, Ops::load(data + i + 2U * Width));
+            extreme3 = selectExtreme<Ops, IsMax>(extreme3, Ops::load(data + i + 3U * Width));
+        }
+        extreme = selectExtreme<Ops, IsMax>(selectExtreme<Ops, IsMax>(extreme, extreme1),
+                                            selectExtreme<Ops, IsMax>(extreme2, extreme3));
+    }
+    for (; i < size; i += Width)
+    {
+        const auto* const block = data + (i + Width <= size ? i : size - Width);
+        extreme = selectExtreme<Ops, IsMax>(extreme, Ops::load(block));
+    }
+
+    T lanes[Width];
+    Ops::store(lanes, extreme);
+    auto result = lanes[0U];
+    for (const auto lane : lanes)
+    {
+        result = selectExtreme<ScalarOps<T>, IsMax>(result, lane);
+    }
+    return find<Ops>(data, size, result);
+}
+
+// "ExtremeOps" allows to take minimum and maximum from other kernels if instructions for them are missing.
+template <typename Ops, typename ExtremeOps, typename T = typename Ops::value_type>
+Kernels<T> makeKernels(std::true_type /*integral*/)
+{
+    return {&find<Ops, T>,
+            &count<Ops, T>,
+            nullptr,
+            &sum<Ops, T>,
+            &findExtreme<ExtremeOps, false, T>,
+            &findExtreme<ExtremeOps, true, T>};
+}
+
+template <typename Ops, typename ExtremeOps, typename T = typename Ops::value_type>
+Kernels<T> makeKernels(std::false_type /*integral*/)
+{
+    return {&find<Ops, T>, &count<Ops, T>, &equal<Ops, T>, nullptr, nullptr, nullptr};
+}
+
+template <typename Ops, typename ExtremeOps = Ops>
+Kernels<typename Ops::value_type> makeKernels()
+{
+    return makeKernels<Ops, ExtremeOps>(std::is_integral<typename Ops::value_type>());
+}
+} // namespace
+} // namespace AlgorithmsDetails
+} // namespace SCONE
@@ -0,0 +1,355 @@
+#include "AlgorithmsKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <emmintrin.h>
+
+namespace SCONE
+{
+namespace AlgorithmsDetails
+{
+namespace Sse2
+{
+namespace
+{
+template <size_t LaneSize>
+struct Lanes;
+
+template <>
+struct Lanes<1U>
+{
+    static __m128i broadcast(const int8_t value)
+    {
+        return _mm_set1_epi8(value);
+    }
+
+    static __m128i equal(const __m128i a, const __m128i b)
+    {
+        return _mm_cmpeq_epi8(a, b);
+    }
+
+    static __m128i greater(const __m128i a, const __m128i b)
+    {
+        return _mm_cmpgt_epi8(a, b);
+    }
+
+    static __m128i add(const __m128i a, const __m128i b)
+    {
+        return _mm_add_epi8(a, b);
+    }
+
+    static __m128i subtract(const __m128i a, const __m128i b)
+    {
+        return _mm_sub_epi8(a, b);
+    }
+};
+
+template <>
+struct Lanes<2U>
+{
+    static __m128i broadcast(const int16_t value)
+    {
+        return _mm_set1_epi16(value);
+    }
+
+    static __m128i equal(const __m128i a, const __m128i b)
+    {
+        return _mm_cmpeq_epi16(a, b);
+    }
+
+    static __m128i greater(const __m128i a, const __m128i b)
+    {
+        return _mm_cmpgt_epi16(a, b);
+    }
+
+    static __m128i add(const __m128i a, const __m128i b)
+    {
+        return _mm_add_epi16(a, b);
+    }
+
+    static __m128i subtract(const __m128i a, const __m128i b)
+    {
+        return _mm_sub_epi16(a, b);
+    }
+};
+
+template <>
+struct Lanes<4U>
+{
+    static __m128i broadcast(const int32_t value)
+    {
+        return _mm_set1_epi32(value);
+    }
+
+    static __m128i equal(const __m128i a, const __m128i b)
+    {
+        return _mm_cmpeq_epi32(a, b);
+    }
+
+    static __m128i greater(const __m128i a, const __m128i b)
+    {
+        return _mm_cmpgt_epi32(a, b);
+    }
+
+    static __m128i add(const __m128i a, const __m128i b)
+    {
+        return _mm_add_epi32(a, b);
+    }
+
+    static __m128i subtract(const __m128i a, const __m128i b)
+    {
+        return _mm_sub_epi32(a, b);
+    }
+};
+
+// There is no 64-bit comparison before SSE4.2, so minimum and maximum use the scalar kernels.
+template <>
+struct Lanes<8U>
+{
+    static __m128i broadcast(const int64_t value)
+    {
+        return _mm_set1_epi64x(value);
+    }
+
+    // Both 32-bit halves have to match.
+    static __m128i equal(const __m128i a, const __m128i b)
+    {
+        const auto halves = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    static __m128i add(const __m128i a, const __m128i b)
+    {
+        return _mm_add_epi64(a, b);
+    }
+
+    static __m128i subtract(const __m128i a, const __m128i b)
+    {
+        return _mm_sub_epi64(a, b);
+    }
+};
+
+// Counters are unsigned lanes of "Lane" type.
+template <typename Lane>
+size_t sumLanes(const __m128i counters)
+{
+    Lane lanes[sizeof(counters) / sizeof(Lane)];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counters);
+    size_t result = 0U;
+    for (const auto lane : lanes)
+    {
+        result += lane;
+    }
+    return result;
+}
+
+template <typename T>
+struct IntegerOps
+{
+    using value_type = T;
+    using Vector = __m128i;
+    using LanesType = Lanes<sizeof(T)>;
+
+    static constexpr size_t Width = sizeof(Vector) / sizeof(T);
+    static constexpr uint32_t FullMask = 0xFFFFU;
+
+    static Vector load(const T* ptr)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const Vector*>(ptr));
+    }
+
+    static Vector broadcast(const T value)
+    {
+        return LanesType::broadcast(static_cast<std::make_signed_t<T>>(value));
+    }
+
+    static uint32_t equalMask(const Vector a, const Vector b)
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(LanesType::equal(a, b)));
+    }
+
+    using Counters = Vector;
+
+    static Counters zeroCounters()
+    {
+        return _mm_setzero_si128();
+    }
+
+    // Matching lanes are all ones, i.e. -1.
+    static Counters countEqual(const Counters counters, const Vector a, const Vector b)
+    {
+        return LanesType::subtract(counters, LanesType::equal(a, b));
+    }
+
+    static size_t sumCounters(const Counters counters)
+    {
+        return sumLanes<std::make_unsigned_t<T>>(counters);
+    }
+
+    static Vector add(const Vector a, const Vector b)
+    {
+        return LanesType::add(a, b);
+    }
+
+    static Vector min(const Vector a, const Vector b)
+    {
+        return select(greater(a, b), b, a);
+    }
+
+    static Vector max(const Vector a, const Vector b)
+    {
+        return select(greater(a, b), a, b);
+    }
+
+    static void store(T* out, const Vector value)
+    {
+        _mm_storeu_si128(reinterpret_cast<Vector*>(out), value);
+    }
+
+private:
+    static Vector greater(const Vector a, const Vector b)
+    {
+        return greater(a, b, std::is_signed<T>());
+    }
+
+    static Vector greater(const Vector a, const Vector b, std::true_type /*signed*/)
+    {
+        return LanesType::greater(a, b);
+    }
+
+    // Unsigned lanes are compared as signed ones with flipped sign bits.
+    static Vector greater(const Vector a, const Vector b, std::false_type /*signed*/)
+    {
+        const auto sign = broadcast(static_cast<T>(T(1U) << (sizeof(T) * 8U - 1U)));
+        return LanesType::greater(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+    }
+
+    static Vector select(const Vector mask, const Vector a, const Vector b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+};
+
+struct FloatOps
+{
+    using value_type = float;
+    using Vector = __m128;
+
+    static constexpr size_t Width = sizeof(Vector) / sizeof(float);
+    static constexpr uint32_t FullMask = 0xFFFFU;
+
+    static Vector load(const float* ptr)
+    {
+        return _mm_loadu_ps(ptr);
+    }
+
+    static Vector broadcast(const float value)
+    {
+        return _mm_set1_ps(value);
+    }
+
+    static uint32_t equalMask(const Vector a, const Vector b)
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(a, b))));
+    }
+
+    using Counters = __m128i;
+
+    static Counters zeroCounters()
+    {
+        return _mm_setzero_si128();
+    }
+
+    static Counters countEqual(const Counters counters, const Vector a, const Vector b)
+    {
+        return _mm_sub_epi32(counters, _mm_castps_si128(_mm_cmpeq_ps(a, b)));
+    }
+
+    static size_t sumCounters(const Counters counters)
+    {
+        return sumLanes<uint32_t>(counters);
+    }
+};
+
+struct DoubleOps
+{
+    using value_type = double;
+    using Vector = __m128d;
+
+    static constexpr size_t Width = sizeof(Vector) / sizeof(double);
+    static constexpr uint32_t FullMask = 0xFFFFU;
+
+    static Vector load(const double* ptr)
+    {
+        return _mm_loadu_pd(ptr);
+    }
+
+    static Vector broadcast(const double value)
+    {
+        return _mm_set1_pd(value);
+    }
+
+    static uint32_t equalMask(const Vector a, const Vector b)
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(a, b))));
+    }
+
+    using Counters = __m128i;
+
+    static Counters zeroCounters()
+    {
+        return _mm_setzero_si128();
+    }
+
+    static Counters countEqual(const Counters counters, const Vector a, const Vector b)
+    {
+        return _mm_sub_epi64(counters, _mm_castpd_si128(_mm_cmpeq_pd(a, b)));
+    }
+
+    static size_t sumCounters(const Counters counters)
+    {
+        return sumLanes<uint64_t>(counters);
+    }
+};
+
+template <typename T>
+struct Ops : IntegerOps<T>
+{
+};
+
+template <>
+struct Ops<float> : FloatOps
+{
+};
+
+template <>
+struct Ops<double> : DoubleOps
+{
+};
+
+template <typename T>
+using ExtremeOps = std::conditional_t<std::is_integral<T>::value && sizeof(T) == 8U, ScalarOps<T>, Ops<T>>;
+} // namespace
+
+template <typename T>
+const Kernels<T>& getKernels()
+{
+    static const auto kernels = makeKernels<Ops<T>, ExtremeOps<T>>();
+    return kernels;
+}
+
+template const Kernels<int8_t>& getKernels();
+template const Kernels<uint8_t>& getKernels();
+template const Kernels<int16_t>& getKernels();
+template const Kernels<uint16_t>& getKernels();
+template const Kernels<int32_t>& getKernels();
+template const Kernels<uint32_t>& getKernels();
+template const Kernels<int64_t>& getKernels();
+template const Kernels<uint64_t>& getKernels();
+template const Kernels<float>& getKernels();
+template const Kernels<double>& getKernels();
+} // namespace Sse2
+} // namespace AlgorithmsDetails
+} // namespace SCONE
+
+#endif
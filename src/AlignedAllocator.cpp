@@ -0,0 +1,59 @@
+#include "AlignedAllocator.h"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace SCONE
+{
+namespace AlignedDetails
+{
+void* allocate(const size_t bytes, const size_t alignment)
+{
+    if (alignment <= alignof(std::max_align_t))
+    {
+        return operator new(bytes);
+    }
+
+#if defined(__cpp_aligned_new)
+    return operator new(bytes, std::align_val_t(alignment));
+#else
+    void* result = nullptr;
+#if defined(_WIN32)
+    result = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&result, alignment, bytes))
+    {
+        result = nullptr;
+    }
+#endif
+    if (!result)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+#endif
+}
+
+void deallocate(void* ptr, size_t, const size_t alignment)
+{
+    if (alignment <= alignof(std::max_align_t))
+    {
+        operator delete(ptr);
+        return;
+    }
+
+#if defined(__cpp_aligned_new)
+    operator delete(ptr, std::align_val_t(alignment));
+#elif defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace AlignedDetails
+} // namespace SCONE
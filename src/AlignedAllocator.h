@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace SCONE
+{
+namespace AlignedDetails
+{
+// Same as aligned operator new/delete, which C++14 lacks. Alignment must be a power of two.
+void* allocate(size_t bytes, size_t alignment);
+void deallocate(void* ptr, size_t bytes, size_t alignment);
+} // namespace AlignedDetails
+
+// Allocator which aligns blocks to at least "Alignment" bytes, e.g. to a cache line or a SIMD register.
+template <typename T, size_t Alignment = alignof(T)>
+class AlignedAllocator
+{
+    static_assert(Alignment && !(Alignment & (Alignment - 1U)), "Alignment must be a power of two");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    static constexpr size_t BlockAlignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+public:
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(AlignedDetails::allocate(count * sizeof(T), BlockAlignment));
+    }
+
+    void deallocate(T* ptr, size_t count)
+    {
+        AlignedDetails::deallocate(ptr, count * sizeof(T), BlockAlignment);
+    }
+};
+
+template <typename T, size_t Alignment>
+constexpr size_t AlignedAllocator<T, Alignment>::BlockAlignment;
+
+template <typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return true;
+}
+
+template <typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return false;
+}
+
+} // namespace SCONE
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace SCONE
+{
+// Result of allocations which may return more elements than requested, same as C++23 std::allocation_result.
+template <typename Pointer>
+struct AllocationResult
+{
+    Pointer ptr;
+    size_t count;
+};
+
+// Optional allocator extensions used by the storages:
+//   AllocationResult<T*> allocate_at_least(size_t count) - reports usable size of the block, which is kept as capacity;
+//   AllocationResult<T*> reallocate(T* ptr, size_t oldCount, size_t newCount) - resizes the block keeping its bytes.
+// Blocks are deallocated with any count between the requested and the reported one.
+template <typename Allocator, typename = void>
+struct HasAllocateAtLeast : std::false_type
+{
+};
+
+template <typename Allocator>
+struct HasAllocateAtLeast<Allocator, decltype(void(std::declval<Allocator&>().allocate_at_least(size_t())))>
+    : std::true_type
+{
+};
+
+template <typename Allocator, typename = void>
+struct HasReallocate : std::false_type
+{
+};
+
+template <typename Allocator>
+struct HasReallocate<Allocator,
+                     decltype(void(std::declval<Allocator&>().reallocate(
+                         std::declval<typename Allocator::value_type*>(), size_t(), size_t())))> : std::true_type
+{
+};
+
+namespace AllocatorDetails
+{
+template <typename Allocator>
+AllocationResult<typename Allocator::value_type*> allocateAtLeast(Allocator& allocator, const size_t count, std::true_type)
+{
+    return allocator.allocate_at_least(count);
+}
+
+template <typename Allocator>
+AllocationResult<typename Allocator::value_type*> allocateAtLeast(Allocator& allocator, const size_t count, std::false_type)
+{
+    return {std::allocator_traits<Allocator>::allocate(allocator, count), count};
+}
+} // namespace AllocatorDetails
+
+template <typename Allocator>
+AllocationResult<typename Allocator::value_type*> allocateAtLeast(Allocator& allocator, const size_t count)
+{
+    return AllocatorDetails::allocateAtLeast(allocator, count, HasAllocateAtLeast<Allocator>());
+}
+
+} // namespace SCONE
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "GrowthPolicy.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace SCONE
+{
+// Index math of buckets of doubling size, which never move once allocated. Bucket "k" keeps elements from
+// B * (2^k - 1) to B * (2^(k + 1) - 1), where B is the size of the first bucket, so element "i" is found in O(1).
+template <typename T>
+struct BucketLayout final
+{
+    // First bucket takes about 256 bytes.
+    static constexpr size_t FirstBucketBits =
+        static_cast<size_t>(getHighestBit(std::max<size_t>(1U, 256U / sizeof(T))));
+    static constexpr size_t MaxBucketCount = std::numeric_limits<size_t>::digits - FirstBucketBits - 1U;
+
+    static size_t getBucket(const size_t index)
+    {
+        return static_cast<size_t>(getHighestBit((index >> FirstBucketBits) + 1U));
+    }
+
+    static size_t getBucketStart(const size_t bucket)
+    {
+        return ((size_t(1U) << bucket) - 1U) << FirstBucketBits;
+    }
+
+    static size_t getBucketSize(const size_t bucket)
+    {
+        return size_t(1U) << (bucket + FirstBucketBits);
+    }
+};
+
+} // namespace SCONE
@@ -0,0 +1,267 @@
+#pragma once
+
+#include "BucketLayout.h"
+#include "GrowthPolicy.h"
+#include "IndexIterator.h"
+#include "MemoryResource.h"
+#include "TaggedPtr.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace SCONE
+{
+// Append-only sequence which many threads may push to and read from at once without locks. push_back() takes
+// an index with one atomic increment and constructs the element in place, as buckets of doubling size,
+// laid out as in BucketLayout, never move. An element may be read by any thread which learnt its index from
+// the pushing thread, e.g. through an atomic or a queue, while other threads keep pushing. size() counts elements
+// being constructed too, so iterating all elements requires pushing threads to finish, e.g. to be joined.
+// The next bucket is published by the thread which half-fills the current one, so pushing threads rarely wait
+// for allocations. Allocation failures in push_back() terminate the program, as the taken index can't be given
+// back; reserve() allocates buckets in advance and reports failures with exceptions.
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentVector final : private VectorDetails::StorageDetails::AllocatorHolder<Allocator>
+{
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using iterator = IndexIterator<ConcurrentVector, T>;
+    using const_iterator = IndexIterator<const ConcurrentVector, const T>;
+
+public:
+    ConcurrentVector()
+        : ConcurrentVector(Allocator())
+    {
+    }
+
+    explicit ConcurrentVector(const Allocator& allocator)
+        : VectorDetails::StorageDetails::AllocatorHolder<Allocator>(allocator)
+    {
+    }
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector()
+    {
+        for (size_t index = 0U, size = this->size(); index < size; ++index)
+        {
+            VectorDetails::StorageDetails::destroy((*this)[index]);
+        }
+        for (auto& bucket : _buckets)
+        {
+            if (auto* data = bucket.load(std::memory_order_relaxed).template getAs<T>())
+            {
+                deallocateBucket(data, static_cast<size_t>(&bucket - _buckets));
+            }
+        }
+    }
+
+    size_t size() const
+    {
+        return _size.load(std::memory_order_acquire);
+    }
+
+    bool empty() const
+    {
+        return size() == 0U;
+    }
+
+    size_t max_size() const
+    {
+        return std::min<size_t>(Buckets::getBucketStart(Buckets::MaxBucketCount),
+                                std::numeric_limits<ptrdiff_t>::max() / sizeof(T));
+    }
+
+    allocator_type get_allocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
+    reference operator[](const size_t index)
+    {
+        assert(index < size());
+        const auto bucket = Buckets::getBucket(index);
+        auto* data = _buckets[bucket].load(std::memory_order_acquire).template getAs<T>();
+        return data[index - Buckets::getBucketStart(bucket)];
+    }
+
+    const_reference operator[](const size_t index) const
+    {
+        return const_cast<ConcurrentVector&>(*this)[index];
+    }
+
+    iterator begin()
+    {
+        return {this, 0U};
+    }
+
+    const_iterator begin() const
+    {
+        return {this, 0U};
+    }
+
+    iterator end()
+    {
+        return {this, size()};
+    }
+
+    const_iterator end() const
+    {
+        return {this, size()};
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    // Returns index of the element. Arguments are moved into a temporary first if the element can't be
+    // constructed from them without exceptions, so that a taken index always gets an element.
+    template <class... Args>
+    size_t emplace_back(Args&&... args)
+    {
+        return emplaceBack(std::is_nothrow_constructible<T, Args&&...>(), std::forward<Args>(args)...);
+    }
+
+    size_t push_back(const T& value)
+    {
+        return emplace_back(value);
+    }
+
+    size_t push_back(T&& value)
+    {
+        return emplace_back(std::move(value));
+    }
+
+    // Publishes buckets for at least "capacity" elements, may be called concurrently with push_back().
+    void reserve(const size_t capacity)
+    {
+        if (capacity > max_size())
+        {
+            VectorDetails::throwLengthError();
+        }
+
+        for (size_t bucket = 0U; capacity > Buckets::getBucketStart(bucket); ++bucket)
+        {
+            publishBucket(bucket);
+        }
+    }
+
+private:
+    // Bucket pointers, the flag marks a bucket which is being allocated.
+    using BucketPtr = TaggedPtr<1U>;
+
+    using Buckets = BucketLayout<T>;
+    // Number of times a thread yields to the one allocating a bucket, before it allocates the bucket itself.
+    static constexpr size_t AllocationWaitCount = 16U;
+
+    static_assert(std::is_nothrow_move_constructible<T>::value, "Elements must be nothrow move constructible");
+
+    template <class... Args>
+    size_t emplaceBack(std::true_type, Args&&... args)
+    {
+        const auto index = _size.fetch_add(1U, std::memory_order_relaxed);
+        new (getSlot(index)) T(std::forward<Args>(args)...);
+        return index;
+    }
+
+    template <class... Args>
+    size_t emplaceBack(std::false_type, Args&&... args)
+    {
+        T value(std::forward<Args>(args)...);
+        return emplaceBack(std::true_type(), std::move(value));
+    }
+
+    T* getSlot(const size_t index) noexcept
+    {
+        const auto bucket = Buckets::getBucket(index);
+        const auto offset = index - Buckets::getBucketStart(bucket);
+        if (offset == Buckets::getBucketSize(bucket) / 2U && bucket + 1U < Buckets::MaxBucketCount)
+        {
+            publishBucket(bucket + 1U);
+        }
+
+        auto* data = _buckets[bucket].load(std::memory_order_acquire).template getAs<T>();
+        return (data ? data : publishBucket(bucket)) + offset;
+    }
+
+    // Returns the bucket, allocating it unless another thread did. The first thread marks the bucket as being
+    // allocated, others wait for it a while and then allocate their own copy, so that growth stays lock-free.
+    // The first copy installed is kept.
+    T* publishBucket(const size_t bucket)
+    {
+        auto& slot = _buckets[bucket];
+        auto current = slot.load(std::memory_order_acquire);
+        if (!current && !current.hasFlag())
+        {
+            BucketPtr allocating;
+            allocating.setFlag(true);
+            if (slot.compareExchange(current, allocating, std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return installBucket(bucket, allocating);
+            }
+        }
+
+        for (size_t i = 0U; i < AllocationWaitCount && !current; ++i)
+        {
+            std::this_thread::yield();
+            current = slot.load(std::memory_order_acquire);
+        }
+        return current ? current.template getAs<T>() : installBucket(bucket, current);
+    }
+
+    // Allocates the bucket and installs it in place of "expected", which has no pointer.
+    T* installBucket(const size_t bucket, BucketPtr expected)
+    {
+        auto* data = std::allocator_traits<Allocator>::allocate(this->getAllocatorRef(), Buckets::getBucketSize(bucket));
+        const BucketPtr desired(static_cast<void*>(data));
+        while (!expected)
+        {
+            if (_buckets[bucket].compareExchange(expected, desired, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                return data;
+            }
+        }
+        deallocateBucket(data, bucket);
+        return expected.template getAs<T>();
+    }
+
+    void deallocateBucket(T* data, const size_t bucket)
+    {
+        std::allocator_traits<Allocator>::deallocate(this->getAllocatorRef(), data, Buckets::getBucketSize(bucket));
+    }
+
+private:
+    std::atomic<size_t> _size{0U};
+    AtomicTaggedPtr<1U> _buckets[Buckets::MaxBucketCount];
+};
+
+namespace pmr
+{
+template <typename T>
+using ConcurrentVector = SCONE::ConcurrentVector<T, PolymorphicAllocator<T>>;
+} // namespace pmr
+
+} // namespace SCONE
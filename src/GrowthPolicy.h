@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace SCONE
+{
+// Returns index of the highest set bit or -1 for zero.
+constexpr int8_t getHighestBit(const size_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return value ? static_cast<int8_t>(sizeof(unsigned long long) * 8U - 1U - __builtin_clzll(value)) : -1;
+#else
+    int8_t result = -1;
+    for (auto rest = value; rest; rest >>= 1U)
+    {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+// Returns "a + b" or the maximum size_t on overflow.
+constexpr size_t addSaturated(const size_t a, const size_t b)
+{
+    return a > std::numeric_limits<size_t>::max() - b ? std::numeric_limits<size_t>::max() : a + b;
+}
+
+// Growth policies return capacity for at least "size" elements when "capacity" is exhausted.
+// Results saturate at the maximum size_t instead of overflowing.
+
+// Rounds capacity up to 2^k - 1.
+struct PowerOfTwoGrowth final
+{
+    static constexpr size_t getNextCapacity(const size_t, const size_t size)
+    {
+        return getHighestBit(size) + 1 < std::numeric_limits<size_t>::digits
+                   ? (size_t(1U) << (getHighestBit(size) + 1)) - 1U
+                   : std::numeric_limits<size_t>::max();
+    }
+};
+
+// Grows capacity by 50%, for memory sensitive containers.
+struct OneAndHalfGrowth final
+{
+    static constexpr size_t getNextCapacity(const size_t capacity, const size_t size)
+    {
+        return size > addSaturated(capacity, capacity / 2U) ? size : addSaturated(capacity, capacity / 2U);
+    }
+};
+
+template <size_t Increment>
+struct FixedIncrementGrowth final
+{
+    static_assert(Increment > 0U, "Increment must be positive");
+
+    static constexpr size_t getNextCapacity(const size_t capacity, const size_t size)
+    {
+        return size > addSaturated(capacity, Increment) ? size : addSaturated(capacity, Increment);
+    }
+};
+
+// Allocates exactly the requested size.
+struct ExactGrowth final
+{
+    static constexpr size_t getNextCapacity(const size_t, const size_t size)
+    {
+        return size;
+    }
+};
+
+} // namespace SCONE
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace SCONE
+{
+// Random access iterator of containers with operator[], which finds elements by index.
+template <typename Container, typename T>
+class IndexIterator final
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+public:
+    IndexIterator() = default;
+
+    IndexIterator(Container* container, const size_t index)
+        : _container(container)
+        , _index(index)
+    {
+    }
+
+    // Conversion to const iterator.
+    template <typename OtherContainer, typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+    IndexIterator(const IndexIterator<OtherContainer, U>& other)
+        : _container(other._container)
+        , _index(other._index)
+    {
+    }
+
+    reference operator*() const
+    {
+        return (*_container)[_index];
+    }
+
+    pointer operator->() const
+    {
+        return &**this;
+    }
+
+    reference operator[](const difference_type offset) const
+    {
+        return *(*this + offset);
+    }
+
+    IndexIterator& operator++()
+    {
+        ++_index;
+        return *this;
+    }
+
+    IndexIterator operator++(int)
+    {
+        auto result = *this;
+        ++_index;
+        return result;
+    }
+
+    IndexIterator& operator--()
+    {
+        --_index;
+        return *this;
+    }
+
+    IndexIterator operator--(int)
+    {
+        auto result = *this;
+        --_index;
+        return result;
+    }
+
+    IndexIterator& operator+=(const difference_type offset)
+    {
+        _index += offset;
+        return *this;
+    }
+
+    IndexIterator& operator-=(const difference_type offset)
+    {
+        _index -= offset;
+        return *this;
+    }
+
+    friend IndexIterator operator+(IndexIterator it, const difference_type offset)
+    {
+        return it += offset;
+    }
+
+    friend IndexIterator operator+(const difference_type offset, IndexIterator it)
+    {
+        return it += offset;
+    }
+
+    friend IndexIterator operator-(IndexIterator it, const difference_type offset)
+    {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const IndexIterator& lhs, const IndexIterator& rhs)
+    {
+        return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+    }
+
+    friend bool operator==(const IndexIterator& lhs, const IndexIterator& rhs)
+    {
+        return lhs._index == rhs._index;
+    }
+
+    friend bool operator!=(const IndexIterator& lhs, const IndexIterator& rhs)
+    {
+        return lhs._index != rhs._index;
+    }
+
+    friend bool operator<(const IndexIterator& lhs, const IndexIterator& rhs)
+    {
+        return lhs._index < rhs._index;
+    }
+
+    friend bool operator>(const IndexIterator& lhs, const IndexIterator& rhs)
+    {
+        return lhs._index > rhs._index;
+    }
+
+    friend bool operator<=(const IndexIterator& lhs, const IndexIterator& rhs)
+    {
+        return lhs._index <= rhs._index;
+    }
+
+    friend bool operator>=(const IndexIterator& lhs, const IndexIterator& rhs)
+    {
+        return lhs._index >= rhs._index;
+    }
+
+private:
+    template <typename, typename>
+    friend class IndexIterator;
+
+    Container* _container = nullptr;
+    size_t _index = 0U;
+};
+
+} // namespace SCONE
@@ -0,0 +1,130 @@
+#include "MallocAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace SCONE
+{
+namespace MallocDetails
+{
+namespace
+{
+#if defined(__linux__)
+size_t getMappedSize(const size_t bytes)
+{
+    static const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (bytes + pageSize - 1U) & ~(pageSize - 1U);
+}
+
+bool isMapped(const size_t bytes)
+{
+    return bytes >= MmapThreshold;
+}
+#else
+bool isMapped(const size_t)
+{
+    return false;
+}
+#endif
+} // namespace
+
+void* allocate(const size_t bytes)
+{
+    void* result = nullptr;
+#if defined(__linux__)
+    if (isMapped(bytes))
+    {
+        result = mmap(nullptr, getMappedSize(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (result == MAP_FAILED)
+        {
+            result = nullptr;
+        }
+    }
+    else
+#endif
+    {
+        result = std::malloc(bytes);
+    }
+
+    if (!result)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void deallocate(void* ptr, const size_t bytes)
+{
+#if defined(__linux__)
+    if (isMapped(bytes))
+    {
+        munmap(ptr, getMappedSize(bytes));
+        return;
+    }
+#endif
+    std::free(ptr);
+}
+
+void* reallocate(void* ptr, const size_t oldBytes, const size_t newBytes)
+{
+    void* result = nullptr;
+    if (isMapped(oldBytes) != isMapped(newBytes))
+    {
+        result = allocate(newBytes);
+        std::memcpy(result, ptr, std::min(oldBytes, newBytes));
+        deallocate(ptr, oldBytes);
+        return result;
+    }
+
+#if defined(__linux__)
+    if (isMapped(newBytes))
+    {
+        result = mremap(ptr, getMappedSize(oldBytes), getMappedSize(newBytes), MREMAP_MAYMOVE);
+        if (result == MAP_FAILED)
+        {
+            result = nullptr;
+        }
+    }
+    else
+#endif
+    {
+        result = std::realloc(ptr, newBytes);
+    }
+
+    if (!result)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+size_t getUsableSize(void* ptr, const size_t bytes)
+{
+#if defined(__linux__)
+    if (isMapped(bytes))
+    {
+        return getMappedSize(bytes);
+    }
+#endif
+#if defined(__GLIBC__)
+    // Block must stay below the threshold, otherwise it would be unmapped on deallocation.
+    return std::min(malloc_usable_size(ptr), MmapThreshold - 1U);
+#else
+    (void)ptr;
+    return bytes;
+#endif
+}
+
+} // namespace MallocDetails
+} // namespace SCONE
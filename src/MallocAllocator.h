@@ -0,0 +1,81 @@
+#pragma once
+
+#include "AllocatorTraits.h"
+
+#include <cstddef>
+
+namespace SCONE
+{
+namespace MallocDetails
+{
+// Blocks of at least this size are mapped directly, so that they can be grown with mremap where it is available.
+constexpr size_t MmapThreshold = 256U * 1024U;
+
+void* allocate(size_t bytes);
+void deallocate(void* ptr, size_t bytes);
+void* reallocate(void* ptr, size_t oldBytes, size_t newBytes);
+
+// Returns size of the block, which may be used and then passed to deallocate/reallocate instead of "bytes".
+size_t getUsableSize(void* ptr, size_t bytes);
+} // namespace MallocDetails
+
+// Allocator which is able to resize blocks in place. Containers use "reallocate" to grow buffers of
+// trivially relocatable types without copying, and keep the whole usable size of blocks as capacity.
+template <typename T>
+class MallocAllocator
+{
+public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+public:
+    MallocAllocator() = default;
+
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(MallocDetails::allocate(count * sizeof(T)));
+    }
+
+    AllocationResult<T*> allocate_at_least(size_t count)
+    {
+        return getAllocationResult(MallocDetails::allocate(count * sizeof(T)), count);
+    }
+
+    void deallocate(T* ptr, size_t count)
+    {
+        MallocDetails::deallocate(ptr, count * sizeof(T));
+    }
+
+    // Contents are preserved bytewise. Throws std::bad_alloc and leaves the block untouched on failure.
+    AllocationResult<T*> reallocate(T* ptr, size_t oldCount, size_t newCount)
+    {
+        return getAllocationResult(MallocDetails::reallocate(ptr, oldCount * sizeof(T), newCount * sizeof(T)),
+                                   newCount);
+    }
+
+private:
+    static AllocationResult<T*> getAllocationResult(void* ptr, size_t count)
+    {
+        return {static_cast<T*>(ptr), MallocDetails::getUsableSize(ptr, count * sizeof(T)) / sizeof(T)};
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const MallocAllocator<T>&, const MallocAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const MallocAllocator<T>&, const MallocAllocator<U>&)
+{
+    return false;
+}
+
+} // namespace SCONE
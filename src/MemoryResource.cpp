@@ -0,0 +1,32 @@
+#include "MemoryResource.h"
+
+#include "AlignedAllocator.h"
+
+#include <new>
+
+namespace SCONE
+{
+namespace
+{
+class NewDeleteResource final : public MemoryResource
+{
+public:
+    void* allocate(size_t bytes, size_t alignment) override
+    {
+        return AlignedDetails::allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        AlignedDetails::deallocate(ptr, bytes, alignment);
+    }
+};
+} // namespace
+
+MemoryResource* getNewDeleteResource()
+{
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+} // namespace SCONE
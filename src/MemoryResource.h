@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+namespace SCONE
+{
+
+// Runtime counterpart of the Allocator concept, modelled after std::pmr::memory_resource.
+class MemoryResource
+{
+public:
+    virtual ~MemoryResource() = default;
+
+    virtual void* allocate(size_t bytes, size_t alignment) = 0;
+    virtual void deallocate(void* ptr, size_t bytes, size_t alignment) = 0;
+
+    virtual bool isEqual(const MemoryResource& other) const
+    {
+        return this == &other;
+    }
+};
+
+// Returns resource which uses global operator new/delete.
+MemoryResource* getNewDeleteResource();
+
+template <typename T>
+class PolymorphicAllocator final
+{
+public:
+    using value_type = T;
+
+public:
+    PolymorphicAllocator()
+        : PolymorphicAllocator(getNewDeleteResource())
+    {
+    }
+
+    PolymorphicAllocator(MemoryResource* resource)
+        : _resource(resource)
+    {
+        assert(_resource);
+    }
+
+    template <typename U>
+    PolymorphicAllocator(const PolymorphicAllocator<U>& other)
+        : PolymorphicAllocator(other.getResource())
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(_resource->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t count)
+    {
+        _resource->deallocate(ptr, count * sizeof(T), alignof(T));
+    }
+
+    // Same as std::pmr: copy of a container doesn't inherit the resource of the original.
+    PolymorphicAllocator select_on_container_copy_construction() const
+    {
+        return PolymorphicAllocator();
+    }
+
+    MemoryResource* getResource() const
+    {
+        return _resource;
+    }
+
+private:
+    MemoryResource* _resource;
+};
+
+template <typename T, typename U>
+bool operator==(const PolymorphicAllocator<T>& lhs, const PolymorphicAllocator<U>& rhs)
+{
+    return lhs.getResource() == rhs.getResource() || lhs.getResource()->isEqual(*rhs.getResource());
+}
+
+template <typename T, typename U>
+bool operator!=(const PolymorphicAllocator<T>& lhs, const PolymorphicAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace SCONE
@@ -0,0 +1,102 @@
+#include "MonotonicBufferResource.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace SCONE
+{
+namespace
+{
+constexpr size_t InitialChunkSize = 1024U;
+
+char* alignUp(char* ptr, const size_t alignment)
+{
+    const auto address = reinterpret_cast<uintptr_t>(ptr);
+    return ptr + (((address + alignment - 1U) & ~(uintptr_t(alignment) - 1U)) - address);
+}
+} // namespace
+
+// Chunks are linked through their headers, blocks follow the header.
+struct MonotonicBufferResource::Chunk
+{
+    Chunk* next;
+    size_t size;
+    size_t alignment;
+};
+
+MonotonicBufferResource::MonotonicBufferResource(MemoryResource* upstream)
+    : MonotonicBufferResource(nullptr, 0U, upstream)
+{
+}
+
+MonotonicBufferResource::MonotonicBufferResource(void* buffer, const size_t size, MemoryResource* upstream)
+    : _upstream(upstream)
+    , _buffer(buffer)
+    , _bufferSize(size)
+    , _current(static_cast<char*>(buffer))
+    , _end(static_cast<char*>(buffer) + size)
+    , _nextChunkSize(std::max(size, InitialChunkSize))
+{
+    assert(_upstream);
+    assert(buffer || !size);
+}
+
+MonotonicBufferResource::~MonotonicBufferResource()
+{
+    release();
+}
+
+void* MonotonicBufferResource::allocate(const size_t bytes, const size_t alignment)
+{
+    assert(alignment && !(alignment & (alignment - 1U)));
+    if (_current)
+    {
+        auto* result = alignUp(_current, alignment);
+        if (result <= _end && bytes <= static_cast<size_t>(_end - result))
+        {
+            _current = result + bytes;
+            return result;
+        }
+    }
+    return allocateFromChunk(bytes, alignment);
+}
+
+void* MonotonicBufferResource::allocateFromChunk(const size_t bytes, const size_t alignment)
+{
+    const auto chunkAlignment = std::max(alignment, alignof(Chunk));
+    const auto headerSize = (sizeof(Chunk) + chunkAlignment - 1U) / chunkAlignment * chunkAlignment;
+    const auto size = std::max(_nextChunkSize, headerSize + bytes);
+
+    auto* chunk = static_cast<Chunk*>(_upstream->allocate(size, chunkAlignment));
+    *chunk = {_chunks, size, chunkAlignment};
+    _chunks = chunk;
+    _nextChunkSize = size * 2U;
+
+    auto* result = reinterpret_cast<char*>(chunk) + headerSize;
+    _current = result + bytes;
+    _end = reinterpret_cast<char*>(chunk) + size;
+    return result;
+}
+
+void MonotonicBufferResource::release()
+{
+    // The next chunk gets the total size of the released ones, so that the reused arena needs one chunk
+    // for the same amount of memory.
+    size_t chunksSize = 0U;
+    while (_chunks)
+    {
+        auto* chunk = _chunks;
+        _chunks = chunk->next;
+        chunksSize += chunk->size;
+        _upstream->deallocate(chunk, chunk->size, chunk->alignment);
+    }
+    _current = static_cast<char*>(_buffer);
+    _end = _current + _bufferSize;
+    if (chunksSize)
+    {
+        _nextChunkSize = chunksSize;
+    }
+}
+
+} // namespace SCONE
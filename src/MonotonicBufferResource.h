@@ -0,0 +1,56 @@
+#pragma once
+
+#include "MemoryResource.h"
+
+#include <cstddef>
+
+namespace SCONE
+{
+
+// Arena which bump-allocates blocks from a caller-supplied buffer and then from chunks of the upstream resource,
+// modelled after std::pmr::monotonic_buffer_resource. Deallocation is a no-op, memory of all blocks is reclaimed
+// at once by release() or destruction, so containers which use the resource must be destroyed or not used after.
+// Meant for short-lived containers, e.g. pmr::InlineVector instances built while handling one request.
+// Not thread-safe.
+class MonotonicBufferResource final : public MemoryResource
+{
+public:
+    explicit MonotonicBufferResource(MemoryResource* upstream = getNewDeleteResource());
+    MonotonicBufferResource(void* buffer, size_t size, MemoryResource* upstream = getNewDeleteResource());
+
+    MonotonicBufferResource(const MonotonicBufferResource&) = delete;
+    MonotonicBufferResource& operator=(const MonotonicBufferResource&) = delete;
+
+    ~MonotonicBufferResource() override;
+
+    void* allocate(size_t bytes, size_t alignment) override;
+
+    void deallocate(void*, size_t, size_t) override
+    {
+    }
+
+    // Returns chunks to the upstream resource and starts allocating from the beginning of the buffer again.
+    void release();
+
+    MemoryResource* getUpstream() const
+    {
+        return _upstream;
+    }
+
+private:
+    struct Chunk;
+
+    void* allocateFromChunk(size_t bytes, size_t alignment);
+
+private:
+    MemoryResource* _upstream;
+    void* _buffer;
+    size_t _bufferSize;
+    char* _current;
+    char* _end;
+    Chunk* _chunks = nullptr;
+    // Size of the next chunk, which grows geometrically.
+    size_t _nextChunkSize;
+};
+
+} // namespace SCONE
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+
+namespace SCONE
+{
+namespace VectorDetails
+{
+// Throws std::length_error. Kept out of line, so vectors of every type share it.
+[[noreturn]] void throwLengthError();
+} // namespace VectorDetails
+
+// Overflow policies handle requests for more elements than max_size() of a vector.
+// Use try_push_back/try_emplace_back to append only if an element fits without reallocation.
+
+// Throws std::length_error, as std::vector does.
+struct ThrowOnOverflow final
+{
+    [[noreturn]] static void onOverflow()
+    {
+        VectorDetails::throwLengthError();
+    }
+};
+
+// Asserts in debug builds and aborts in release ones, for code paths which must not throw.
+struct AssertOnOverflow final
+{
+    [[noreturn]] static void onOverflow()
+    {
+        assert(!"SCONE::Vector size exceeds max_size()");
+        std::abort();
+    }
+};
+
+} // namespace SCONE
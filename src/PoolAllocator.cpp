@@ -0,0 +1,251 @@
+#include "PoolAllocator.h"
+
+#include <cassert>
+#include <mutex>
+#include <new>
+
+namespace SCONE
+{
+namespace PoolDetails
+{
+namespace
+{
+// Steps of size classes grow with the size, so that rounding stays within 25%.
+constexpr size_t ClassCount = 16U;
+constexpr size_t ClassSizes[ClassCount] = {8U, 16U, 24U, 32U, 40U, 48U, 56U, 64U,
+                                           80U, 96U, 112U, 128U, 160U, 192U, 224U, 256U};
+
+constexpr size_t SlabSize = 64U * 1024U;
+// Blocks are moved between thread and shared lists in batches, so that the lock is taken once per batch.
+constexpr size_t BatchSize = 64U;
+
+static_assert(ClassSizes[ClassCount - 1U] == MaxBlockSize, "Largest class must match MaxBlockSize");
+
+size_t getClass(const size_t bytes)
+{
+    assert(bytes <= MaxBlockSize);
+    if (bytes <= 64U)
+    {
+        return bytes ? (bytes - 1U) / 8U : 0U;
+    }
+    if (bytes <= 128U)
+    {
+        return 8U + (bytes - 65U) / 16U;
+    }
+    return 12U + (bytes - 129U) / 32U;
+}
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+struct FreeList
+{
+    FreeBlock* head = nullptr;
+    size_t count = 0U;
+
+    void push(void* ptr)
+    {
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = head;
+        head = block;
+        ++count;
+    }
+
+    void* pop()
+    {
+        assert(head);
+        auto* block = head;
+        head = block->next;
+        --count;
+        return block;
+    }
+
+    // Moves up to "blocks" blocks to the front of "other".
+    void moveTo(FreeList& other, const size_t blocks)
+    {
+        for (size_t i = 0U; i < blocks && head; ++i)
+        {
+            other.push(pop());
+        }
+    }
+};
+
+// Slabs are linked through their first bytes, blocks start at BlockOffset.
+struct Slab
+{
+    Slab* next;
+};
+
+constexpr size_t BlockOffset = alignof(std::max_align_t) > sizeof(Slab) ? alignof(std::max_align_t) : sizeof(Slab);
+
+// Lists shared by all threads. Blocks get here when a thread keeps too many of them or exits.
+struct SharedPool
+{
+    std::mutex mutex;
+    FreeList lists[ClassCount];
+    Slab* slabs = nullptr;
+
+    char* allocateSlab()
+    {
+        auto* slab = static_cast<Slab*>(operator new(SlabSize));
+        std::lock_guard<std::mutex> lock(mutex);
+        slab->next = slabs;
+        slabs = slab;
+        return reinterpret_cast<char*>(slab);
+    }
+};
+
+// Never destroyed, so that blocks can be deallocated during destruction of static objects.
+SharedPool& getSharedPool()
+{
+    static auto* pool = new SharedPool();
+    return *pool;
+}
+
+// Free lists of a thread and the rest of its current slab, from which blocks of all classes are carved.
+// Trivially destructible, so it stays usable after the thread-exit cleanup.
+struct ThreadCache
+{
+    FreeList lists[ClassCount];
+    char* slabTail = nullptr;
+    char* slabEnd = nullptr;
+    bool registered = false;
+    // Set by the thread-exit cleanup. Blocks allocated and deallocated later, e.g. by destructors of other
+    // thread_local objects, go through the shared lists, as nothing would return them from this cache.
+    bool released = false;
+};
+
+thread_local ThreadCache threadCache;
+
+// Returns free blocks of an exiting thread to the shared lists. The rest of its slab is lost.
+struct ThreadCacheReleaser
+{
+    ~ThreadCacheReleaser()
+    {
+        auto& pool = getSharedPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        for (size_t i = 0U; i < ClassCount; ++i)
+        {
+            threadCache.lists[i].moveTo(pool.lists[i], threadCache.lists[i].count);
+        }
+        threadCache.slabTail = threadCache.slabEnd = nullptr;
+        threadCache.released = true;
+    }
+};
+
+ThreadCache& getThreadCache()
+{
+    if (!threadCache.registered)
+    {
+        threadCache.registered = true;
+        static thread_local ThreadCacheReleaser releaser;
+        (void)releaser;
+    }
+    return threadCache;
+}
+
+// Fills the empty thread list with a batch of blocks taken from the shared list or carved from the slab.
+void refill(ThreadCache& cache, const size_t sizeClass)
+{
+    auto& list = cache.lists[sizeClass];
+    {
+        auto& pool = getSharedPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.lists[sizeClass].moveTo(list, BatchSize);
+    }
+    if (list.count)
+    {
+        return;
+    }
+
+    const auto blockSize = ClassSizes[sizeClass];
+    if (static_cast<size_t>(cache.slabEnd - cache.slabTail) < blockSize)
+    {
+        cache.slabTail = getSharedPool().allocateSlab() + BlockOffset;
+        cache.slabEnd = cache.slabTail + (SlabSize - BlockOffset);
+    }
+    for (size_t i = 0U; i < BatchSize && static_cast<size_t>(cache.slabEnd - cache.slabTail) >= blockSize; ++i)
+    {
+        list.push(cache.slabTail);
+        cache.slabTail += blockSize;
+    }
+}
+
+// Takes a block from the shared list, carving a new slab into it if the list is empty.
+void* allocateShared(const size_t sizeClass)
+{
+    auto& pool = getSharedPool();
+    auto& list = pool.lists[sizeClass];
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (list.head)
+        {
+            return list.pop();
+        }
+    }
+
+    auto* slab = pool.allocateSlab();
+    const auto blockSize = ClassSizes[sizeClass];
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    for (auto* it = slab + BlockOffset; it + blockSize <= slab + SlabSize; it += blockSize)
+    {
+        list.push(it);
+    }
+    return list.pop();
+}
+} // namespace
+
+AllocationResult<void*> allocate(const size_t bytes)
+{
+    if (bytes > MaxBlockSize)
+    {
+        return {operator new(bytes), bytes};
+    }
+
+    const auto sizeClass = getClass(bytes);
+    auto& cache = getThreadCache();
+    if (cache.released)
+    {
+        return {allocateShared(sizeClass), ClassSizes[sizeClass]};
+    }
+
+    auto& list = cache.lists[sizeClass];
+    if (!list.head)
+    {
+        refill(cache, sizeClass);
+    }
+    return {list.pop(), ClassSizes[sizeClass]};
+}
+
+void deallocate(void* ptr, const size_t bytes)
+{
+    if (bytes > MaxBlockSize)
+    {
+        operator delete(ptr);
+        return;
+    }
+
+    const auto sizeClass = getClass(bytes);
+    auto& cache = getThreadCache();
+    if (cache.released)
+    {
+        auto& pool = getSharedPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.lists[sizeClass].push(ptr);
+        return;
+    }
+
+    auto& list = cache.lists[sizeClass];
+    list.push(ptr);
+    if (list.count > 2U * BatchSize)
+    {
+        auto& pool = getSharedPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        list.moveTo(pool.lists[sizeClass], BatchSize);
+    }
+}
+
+} // namespace PoolDetails
+} // namespace SCONE
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "AllocatorTraits.h"
+
+#include <cstddef>
+
+namespace SCONE
+{
+namespace PoolDetails
+{
+// Blocks up to this size are served from slabs in size classes, larger ones by global operator new.
+constexpr size_t MaxBlockSize = 256U;
+constexpr size_t BlockAlignment = 8U;
+
+// Returns block of at least "bytes" together with its usable size in bytes.
+AllocationResult<void*> allocate(size_t bytes);
+
+// "bytes" may be anything between the requested and the usable size.
+void deallocate(void* ptr, size_t bytes);
+} // namespace PoolDetails
+
+// Allocator for many small blocks, e.g. buffers of millions of small CompactVectors. Blocks are carved from
+// large slabs, so they don't have the per-chunk overhead of malloc, and are kept in per-thread free lists of
+// their size class. Blocks may be deallocated by any thread. Slabs are never returned to the system, freed
+// blocks are only reused by later allocations.
+template <typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= PoolDetails::BlockAlignment, "Over-aligned types are not supported");
+
+public:
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(PoolDetails::allocate(count * sizeof(T)).ptr);
+    }
+
+    // Reports the whole size class, so that containers keep the rounding as capacity.
+    AllocationResult<T*> allocate_at_least(size_t count)
+    {
+        const auto allocation = PoolDetails::allocate(count * sizeof(T));
+        return {static_cast<T*>(allocation.ptr), allocation.count / sizeof(T)};
+    }
+
+    void deallocate(T* ptr, size_t count)
+    {
+        PoolDetails::deallocate(ptr, count * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+    return false;
+}
+
+} // namespace SCONE
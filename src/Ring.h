@@ -0,0 +1,759 @@
+#pragma once
+
+#include "GrowthPolicy.h"
+#include "IndexIterator.h"
+#include "MemoryResource.h"
+#include "Span.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace SCONE
+{
+namespace RingDetails
+{
+// Ring storages keep a buffer of power-of-two capacity together with the position of the first element and
+// the element count. Elements are constructed and destroyed by the Ring, storages only own the buffer.
+
+constexpr bool isPowerOfTwo(const size_t value)
+{
+    return value && !(value & (value - 1U));
+}
+
+// Buffer with a header of head, size and capacity, so that the container is one pointer, as CompactVector.
+// Allocators are propagated on move.
+template <typename T, typename Allocator>
+class CompactRingStorage final : private VectorDetails::StorageDetails::AllocatorHolder<Allocator>
+{
+    struct Header
+    {
+        size_t head;
+        size_t size;
+        size_t capacity;
+    };
+
+    static constexpr size_t UnitSize = std::max(alignof(T), alignof(Header));
+    static constexpr size_t DataOffset = (sizeof(Header) + UnitSize - 1U) / UnitSize * UnitSize;
+
+    using Unit = std::aligned_storage_t<UnitSize, UnitSize>;
+    using UnitAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Unit>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+public:
+    explicit CompactRingStorage(const Allocator& allocator = Allocator())
+        : VectorDetails::StorageDetails::AllocatorHolder<Allocator>(allocator)
+    {
+    }
+
+    CompactRingStorage(const CompactRingStorage&) = delete;
+    CompactRingStorage& operator=(const CompactRingStorage&) = delete;
+
+    CompactRingStorage(CompactRingStorage&& other) noexcept
+        : CompactRingStorage(other.getAllocator())
+    {
+        std::swap(_header, other._header);
+    }
+
+    // Elements of this storage must be destroyed before.
+    CompactRingStorage& operator=(CompactRingStorage&& other) noexcept
+    {
+        if (this != &other)
+        {
+            free();
+            this->getAllocatorRef() = other.getAllocator();
+            std::swap(_header, other._header);
+        }
+        return *this;
+    }
+
+    ~CompactRingStorage()
+    {
+        free();
+    }
+
+    void allocate(const size_t capacity)
+    {
+        assert(!_header && isPowerOfTwo(capacity));
+        UnitAllocator allocator(this->getAllocatorRef());
+        _header = reinterpret_cast<Header*>(std::allocator_traits<UnitAllocator>::allocate(allocator, getUnits(capacity)));
+        *_header = {0U, 0U, capacity};
+    }
+
+    void free()
+    {
+        if (_header)
+        {
+            UnitAllocator allocator(this->getAllocatorRef());
+            std::allocator_traits<UnitAllocator>::deallocate(
+                allocator, reinterpret_cast<Unit*>(_header), getUnits(_header->capacity));
+            _header = nullptr;
+        }
+    }
+
+    size_t head() const
+    {
+        return _header ? _header->head : 0U;
+    }
+
+    size_t size() const
+    {
+        return _header ? _header->size : 0U;
+    }
+
+    size_t capacity() const
+    {
+        return _header ? _header->capacity : 0U;
+    }
+
+    void setHead(const size_t head)
+    {
+        _header->head = head;
+    }
+
+    void setSize(const size_t size)
+    {
+        _header->size = size;
+    }
+
+    T* buffer() const
+    {
+        return _header ? reinterpret_cast<T*>(reinterpret_cast<char*>(_header) + DataOffset) : nullptr;
+    }
+
+    static size_t maxSize()
+    {
+        return (std::numeric_limits<ptrdiff_t>::max() - DataOffset) / sizeof(T);
+    }
+
+    const Allocator& getAllocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
+private:
+    static size_t getUnits(const size_t capacity)
+    {
+        return (DataOffset + capacity * sizeof(T) + UnitSize - 1U) / UnitSize;
+    }
+
+private:
+    Header* _header = nullptr;
+};
+
+// Buffer of "InlineSize" elements inside the container, which is replaced by a heap one when it's exhausted.
+// Allocators are propagated on move.
+template <typename T, uint32_t InlineSize, typename Allocator>
+class InlineRingStorage final : private VectorDetails::StorageDetails::AllocatorHolder<Allocator>
+{
+    static_assert(isPowerOfTwo(InlineSize), "Inline size must be a power of two");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+public:
+    explicit InlineRingStorage(const Allocator& allocator = Allocator())
+        : VectorDetails::StorageDetails::AllocatorHolder<Allocator>(allocator)
+    {
+    }
+
+    InlineRingStorage(const InlineRingStorage&) = delete;
+    InlineRingStorage& operator=(const InlineRingStorage&) = delete;
+
+    InlineRingStorage(InlineRingStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : InlineRingStorage(other.getAllocator())
+    {
+        *this = std::move(other);
+    }
+
+    // Elements of this storage must be destroyed before.
+    InlineRingStorage& operator=(InlineRingStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other)
+        {
+            assert(_size == 0U);
+            free();
+            this->getAllocatorRef() = other.getAllocator();
+            if (other.isInline())
+            {
+                // Elements are moved to the start of the inline buffer. Source elements are destroyed only after
+                // all of them are moved, so that "other" keeps its elements if a move throws.
+                moveInlineElements(other, std::is_nothrow_move_constructible<T>());
+                for (uint32_t i = 0U; i < other._size; ++i)
+                {
+                    VectorDetails::StorageDetails::destroy(other.buffer()[(other._head + i) & (InlineSize - 1U)]);
+                }
+                other._head = other._size = 0U;
+            }
+            else
+            {
+                _head = other._head;
+                _size = other._size;
+                _capacity = other._capacity;
+                getHeapBufferRef() = other.getHeapBufferRef();
+                other._head = other._size = 0U;
+                other._capacity = InlineSize;
+            }
+        }
+        return *this;
+    }
+
+    ~InlineRingStorage()
+    {
+        free();
+    }
+
+    void allocate(const size_t capacity)
+    {
+        assert(isInline() && _size == 0U && isPowerOfTwo(capacity));
+        if (capacity > InlineSize)
+        {
+            auto* heapBuffer = std::allocator_traits<Allocator>::allocate(this->getAllocatorRef(), capacity);
+            _capacity = static_cast<uint32_t>(capacity);
+            getHeapBufferRef() = heapBuffer;
+        }
+    }
+
+    void free()
+    {
+        if (!isInline())
+        {
+            std::allocator_traits<Allocator>::deallocate(this->getAllocatorRef(), getHeapBufferRef(), _capacity);
+            _capacity = InlineSize;
+        }
+        _head = _size = 0U;
+    }
+
+    size_t head() const
+    {
+        return _head;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+    void setHead(const size_t head)
+    {
+        _head = static_cast<uint32_t>(head);
+    }
+
+    void setSize(const size_t size)
+    {
+        _size = static_cast<uint32_t>(size);
+    }
+
+    T* buffer() const
+    {
+        return isInline() ? reinterpret_cast<T*>(const_cast<InlineRingStorage*>(this)->_union.data)
+                          : const_cast<InlineRingStorage*>(this)->getHeapBufferRef();
+    }
+
+    // Largest power of two of uint32_t.
+    static size_t maxSize()
+    {
+        return std::min<size_t>(size_t(1U) << 31U, std::numeric_limits<ptrdiff_t>::max() / sizeof(T));
+    }
+
+    const Allocator& getAllocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
+private:
+    bool isInline() const
+    {
+        return _capacity == InlineSize;
+    }
+
+    void moveInlineElements(InlineRingStorage& other, std::true_type)
+    {
+        for (; _size < other._size; ++_size)
+        {
+            new (buffer() + _size) T(std::move(other.buffer()[(other._head + _size) & (InlineSize - 1U)]));
+        }
+    }
+
+    void moveInlineElements(InlineRingStorage& other, std::false_type)
+    {
+        try
+        {
+            moveInlineElements(other, std::true_type());
+        }
+        catch (...)
+        {
+            VectorDetails::StorageDetails::destroy(buffer(), buffer() + _size);
+            _size = 0U;
+            throw;
+        }
+    }
+
+    T*& getHeapBufferRef()
+    {
+        assert(!isInline());
+        return _union.heapBuffer;
+    }
+
+private:
+    uint32_t _head = 0U;
+    uint32_t _size = 0U;
+    uint32_t _capacity = InlineSize;
+    union Union
+    {
+        Union()
+        {
+        }
+
+        T* heapBuffer;
+        std::aligned_storage_t<sizeof(T[InlineSize]), alignof(T)> data[1];
+    } _union;
+};
+} // namespace RingDetails
+
+// Double-ended queue on a circular buffer of power-of-two capacity, so that elements are found by masking
+// their index and both ends are changed in O(1) without moving other elements. Elements are moved only when
+// the buffer grows. span() returns elements as at most two contiguous parts, e.g. to drain a batch with memcpy.
+template <typename StorageType>
+class Ring final
+{
+public:
+    using value_type = typename StorageType::value_type;
+    using allocator_type = typename StorageType::allocator_type;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using iterator = IndexIterator<Ring, value_type>;
+    using const_iterator = IndexIterator<const Ring, const value_type>;
+
+    using span_type = Span<value_type>;
+    using const_span_type = Span<const value_type>;
+
+public:
+    Ring()
+    {
+    }
+
+    explicit Ring(const allocator_type& allocator)
+        : _storage(allocator)
+    {
+    }
+
+    Ring(const Ring& other)
+        : Ring(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
+    {
+        append(other.begin(), other.end());
+    }
+
+    Ring(std::initializer_list<value_type> list, const allocator_type& allocator = allocator_type())
+        : Ring(allocator)
+    {
+        append(list.begin(), list.end());
+    }
+
+    Ring(Ring&& other) noexcept(std::is_nothrow_move_constructible<StorageType>::value)
+        : _storage(std::move(other._storage))
+    {
+    }
+
+    Ring& operator=(const Ring& other)
+    {
+        if (this != &other)
+        {
+            Ring tmp(get_allocator());
+            tmp.append(other.begin(), other.end());
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    Ring& operator=(Ring&& other) noexcept(std::is_nothrow_move_assignable<StorageType>::value)
+    {
+        if (this != &other)
+        {
+            clear();
+            _storage = std::move(other._storage);
+        }
+        return *this;
+    }
+
+    ~Ring()
+    {
+        clear();
+    }
+
+    size_t size() const
+    {
+        return _storage.size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0U;
+    }
+
+    size_t capacity() const
+    {
+        return _storage.capacity();
+    }
+
+    size_t max_size() const
+    {
+        return StorageType::maxSize();
+    }
+
+    allocator_type get_allocator() const
+    {
+        return _storage.getAllocator();
+    }
+
+    reference operator[](const size_t index)
+    {
+        assert(index < size());
+        return _storage.buffer()[getPosition(index)];
+    }
+
+    const_reference operator[](const size_t index) const
+    {
+        assert(index < size());
+        return _storage.buffer()[getPosition(index)];
+    }
+
+    reference front()
+    {
+        return (*this)[0U];
+    }
+
+    const_reference front() const
+    {
+        return (*this)[0U];
+    }
+
+    reference back()
+    {
+        return (*this)[size() - 1U];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[size() - 1U];
+    }
+
+    iterator begin()
+    {
+        return {this, 0U};
+    }
+
+    const_iterator begin() const
+    {
+        return {this, 0U};
+    }
+
+    iterator end()
+    {
+        return {this, size()};
+    }
+
+    const_iterator end() const
+    {
+        return {this, size()};
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    // Elements from "first" to the end of the ring as contiguous parts, the second one is empty unless
+    // the elements wrap around the end of the buffer.
+    std::pair<span_type, span_type> span(const size_t first = 0U)
+    {
+        assert(first <= size());
+        auto* buffer = _storage.buffer();
+        const auto count = size() - first;
+        const auto position = count ? getPosition(first) : 0U;
+        const auto firstCount = std::min(count, capacity() - position);
+        return {span_type(buffer + position, firstCount), span_type(buffer, count - firstCount)};
+    }
+
+    std::pair<const_span_type, const_span_type> span(const size_t first = 0U) const
+    {
+        const auto result = const_cast<Ring&>(*this).span(first);
+        return {const_span_type(result.first.data(), result.first.size()),
+                const_span_type(result.second.data(), result.second.size())};
+    }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if (size() == capacity())
+        {
+            return emplaceWithGrowth(false, std::forward<Args>(args)...);
+        }
+
+        auto* ptr = _storage.buffer() + getPosition(size());
+        new (ptr) value_type(std::forward<Args>(args)...);
+        _storage.setSize(size() + 1U);
+        return *ptr;
+    }
+
+    void push_back(const value_type& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(value_type&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <class... Args>
+    reference emplace_front(Args&&... args)
+    {
+        if (size() == capacity())
+        {
+            return emplaceWithGrowth(true, std::forward<Args>(args)...);
+        }
+
+        const auto head = (_storage.head() - 1U) & (capacity() - 1U);
+        auto* ptr = _storage.buffer() + head;
+        new (ptr) value_type(std::forward<Args>(args)...);
+        _storage.setHead(head);
+        _storage.setSize(size() + 1U);
+        return *ptr;
+    }
+
+    void push_front(const value_type& value)
+    {
+        emplace_front(value);
+    }
+
+    void push_front(value_type&& value)
+    {
+        emplace_front(std::move(value));
+    }
+
+    template <typename Iterator>
+    void append(Iterator first, const Iterator last)
+    {
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    void pop_back()
+    {
+        assert(!empty());
+        VectorDetails::StorageDetails::destroy(back());
+        _storage.setSize(size() - 1U);
+    }
+
+    void pop_front()
+    {
+        assert(!empty());
+        VectorDetails::StorageDetails::destroy(front());
+        const auto size = this->size() - 1U;
+        _storage.setHead(size ? getPosition(1U) : 0U);
+        _storage.setSize(size);
+    }
+
+    // Removes "count" first elements, e.g. after they were copied from span().
+    void pop_front(const size_t count)
+    {
+        assert(count <= size());
+        if (!count)
+        {
+            return;
+        }
+
+        for (size_t i = 0U; i < count; ++i)
+        {
+            VectorDetails::StorageDetails::destroy((*this)[i]);
+        }
+
+        // Empty ring starts from the buffer start again, so that the next batch is contiguous.
+        const auto size = this->size() - count;
+        _storage.setHead(size ? getPosition(count) : 0U);
+        _storage.setSize(size);
+    }
+
+    // Destroys elements keeping the buffer for reuse.
+    void clear()
+    {
+        pop_front(size());
+    }
+
+    // Destroys elements and frees the buffer.
+    void release()
+    {
+        clear();
+        _storage.free();
+    }
+
+    void reserve(const size_t capacity)
+    {
+        if (capacity > this->capacity())
+        {
+            reallocate(getCapacity(capacity));
+        }
+    }
+
+    void swap(Ring& other)
+    {
+        Ring tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    using IsRelocatable = IsTriviallyRelocatable<value_type>;
+
+    size_t getPosition(const size_t index) const
+    {
+        return (_storage.head() + index) & (capacity() - 1U);
+    }
+
+    // Smallest power of two not less than "capacity".
+    size_t getCapacity(const size_t capacity) const
+    {
+        if (capacity > max_size())
+        {
+            VectorDetails::throwLengthError();
+        }
+        return PowerOfTwoGrowth::getNextCapacity(0U, capacity - 1U) + 1U;
+    }
+
+    // Element is constructed in the new buffer before elements are moved there, so "args" may refer to them.
+    // Elements are moved to the buffer start, so the new front element goes to the buffer end.
+    template <class... Args>
+    reference emplaceWithGrowth(const bool front, Args&&... args)
+    {
+        StorageType storage(get_allocator());
+        storage.allocate(getCapacity(std::max<size_t>(2U * size(), 4U)));
+        const auto position = front ? storage.capacity() - 1U : size();
+        auto* ptr = storage.buffer() + position;
+        new (ptr) value_type(std::forward<Args>(args)...);
+        try
+        {
+            moveElements(storage, IsRelocatable());
+        }
+        catch (...)
+        {
+            VectorDetails::StorageDetails::destroy(*ptr);
+            throw;
+        }
+
+        storage.setHead(front ? position : 0U);
+        storage.setSize(storage.size() + 1U);
+        _storage = std::move(storage);
+        return *ptr;
+    }
+
+    // Moves elements to the start of a new buffer.
+    void reallocate(const size_t capacity)
+    {
+        StorageType storage(get_allocator());
+        storage.allocate(capacity);
+        moveElements(storage, IsRelocatable());
+        _storage = std::move(storage);
+    }
+
+    void moveElements(StorageType& storage, std::true_type)
+    {
+        if (empty())
+        {
+            return;
+        }
+
+        const auto parts = span();
+        std::memcpy(static_cast<void*>(storage.buffer()), parts.first.data(), parts.first.size() * sizeof(value_type));
+        std::memcpy(static_cast<void*>(storage.buffer() + parts.first.size()),
+                    parts.second.data(),
+                    parts.second.size() * sizeof(value_type));
+        storage.setSize(size());
+        _storage.setSize(0U);
+    }
+
+    // Elements are copied if their move constructor may throw, so that the ring stays intact on exceptions.
+    void moveElements(StorageType& storage, std::false_type)
+    {
+        auto* buffer = storage.buffer();
+        size_t moved = 0U;
+        try
+        {
+            for (; moved < size(); ++moved)
+            {
+                new (buffer + moved) value_type(std::move_if_noexcept((*this)[moved]));
+            }
+        }
+        catch (...)
+        {
+            VectorDetails::StorageDetails::destroy(buffer, buffer + moved);
+            throw;
+        }
+        storage.setSize(moved);
+        clear();
+    }
+
+private:
+    StorageType _storage;
+};
+
+template <typename StorageType>
+bool operator==(const Ring<StorageType>& lhs, const Ring<StorageType>& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename StorageType>
+bool operator!=(const Ring<StorageType>& lhs, const Ring<StorageType>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// Deque which takes one pointer and keeps head, size and capacity in the heap buffer.
+template <typename T, typename Allocator = std::allocator<T>>
+using CompactDeque = Ring<RingDetails::CompactRingStorage<T, Allocator>>;
+
+// Ring which keeps up to "InlineSize" elements, a power of two, without heap allocations.
+template <typename T, uint32_t InlineSize = 4U, typename Allocator = std::allocator<T>>
+using InlineRing = Ring<RingDetails::InlineRingStorage<T, InlineSize, Allocator>>;
+
+namespace pmr
+{
+template <typename T>
+using CompactDeque = SCONE::CompactDeque<T, PolymorphicAllocator<T>>;
+
+template <typename T, uint32_t InlineSize = 4U>
+using InlineRing = SCONE::InlineRing<T, InlineSize, PolymorphicAllocator<T>>;
+} // namespace pmr
+
+} // namespace SCONE
@@ -0,0 +1,438 @@
+#pragma once
+
+#include "BucketLayout.h"
+#include "GrowthPolicy.h"
+#include "IndexIterator.h"
+#include "MemoryResource.h"
+#include "Span.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace SCONE
+{
+// Sequence of elements kept in buckets of doubling size, laid out as in BucketLayout, so that appends never move
+// elements, references stay valid until the element is removed and element "i" is found in O(1).
+// Same as CompactVector, the container is one pointer, to a header with size, bucket count and bucket pointers.
+// Buckets are exposed as contiguous segments, e.g. for vectorized scans.
+template <typename T, typename Allocator = std::allocator<T>>
+class SegmentedVector final : private VectorDetails::StorageDetails::AllocatorHolder<Allocator>
+{
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using iterator = IndexIterator<SegmentedVector, T>;
+    using const_iterator = IndexIterator<const SegmentedVector, const T>;
+
+    using segment = Span<T>;
+    using const_segment = Span<const T>;
+
+public:
+    SegmentedVector()
+        : SegmentedVector(Allocator())
+    {
+    }
+
+    explicit SegmentedVector(const Allocator& allocator)
+        : VectorDetails::StorageDetails::AllocatorHolder<Allocator>(allocator)
+    {
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator()))
+    {
+        append(other);
+    }
+
+    SegmentedVector(std::initializer_list<T> list, const Allocator& allocator = Allocator())
+        : SegmentedVector(allocator)
+    {
+        append(list);
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : SegmentedVector(other.get_allocator())
+    {
+        std::swap(_header, other._header);
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& other)
+    {
+        if (this != &other)
+        {
+            SegmentedVector tmp(get_allocator());
+            tmp.append(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    // Allocators are propagated on move and swap.
+    SegmentedVector& operator=(SegmentedVector&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            this->getAllocatorRef() = other.get_allocator();
+            std::swap(_header, other._header);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector()
+    {
+        release();
+    }
+
+    size_t size() const
+    {
+        return _header ? _header->size : 0U;
+    }
+
+    bool empty() const
+    {
+        return size() == 0U;
+    }
+
+    size_t capacity() const
+    {
+        return _header ? Buckets::getBucketStart(_header->bucketCount) : 0U;
+    }
+
+    size_t max_size() const
+    {
+        return std::min<size_t>(Buckets::getBucketStart(Buckets::MaxBucketCount),
+                                std::numeric_limits<ptrdiff_t>::max() / sizeof(T));
+    }
+
+    allocator_type get_allocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
+    reference operator[](const size_t index)
+    {
+        assert(index < size());
+        const auto bucket = Buckets::getBucket(index);
+        return getBuckets()[bucket][index - Buckets::getBucketStart(bucket)];
+    }
+
+    const_reference operator[](const size_t index) const
+    {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    reference front()
+    {
+        return (*this)[0U];
+    }
+
+    const_reference front() const
+    {
+        return (*this)[0U];
+    }
+
+    reference back()
+    {
+        return (*this)[size() - 1U];
+    }
+
+    const_reference back() const
+    {
+        return (*this)[size() - 1U];
+    }
+
+    iterator begin()
+    {
+        return {this, 0U};
+    }
+
+    const_iterator begin() const
+    {
+        return {this, 0U};
+    }
+
+    iterator end()
+    {
+        return {this, size()};
+    }
+
+    const_iterator end() const
+    {
+        return {this, size()};
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    // Number of buckets with elements.
+    size_t segment_count() const
+    {
+        return empty() ? 0U : Buckets::getBucket(size() - 1U) + 1U;
+    }
+
+    // Elements of bucket "index", the last one may be filled partially.
+    segment get_segment(const size_t index)
+    {
+        assert(index < segment_count());
+        const auto start = Buckets::getBucketStart(index);
+        return {getBuckets()[index], std::min(Buckets::getBucketSize(index), size() - start)};
+    }
+
+    const_segment get_segment(const size_t index) const
+    {
+        const auto result = const_cast<SegmentedVector&>(*this).get_segment(index);
+        return {result.data(), result.size()};
+    }
+
+    // Calls "function" with every segment in order, stops if it returns false.
+    template <typename Function>
+    bool for_each_segment(Function function) const
+    {
+        for (size_t i = 0U, count = segment_count(); i < count; ++i)
+        {
+            if (!function(get_segment(i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args)
+    {
+        const auto index = size();
+        if (index == capacity())
+        {
+            addBucket();
+        }
+
+        const auto bucket = Buckets::getBucket(index);
+        auto* ptr = &getBuckets()[bucket][index - Buckets::getBucketStart(bucket)];
+        new (ptr) T(std::forward<Args>(args)...);
+        ++_header->size;
+        return *ptr;
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <typename Range>
+    void append(const Range& range)
+    {
+        for (const auto& value : range)
+        {
+            emplace_back(value);
+        }
+    }
+
+    void pop_back()
+    {
+        assert(!empty());
+        VectorDetails::StorageDetails::destroy(back());
+        --_header->size;
+    }
+
+    // Adds buckets up to "capacity", existing elements stay in place.
+    void reserve(const size_t capacity)
+    {
+        if (capacity > max_size())
+        {
+            VectorDetails::throwLengthError();
+        }
+
+        while (capacity > this->capacity())
+        {
+            addBucket();
+        }
+    }
+
+    // Destroys elements keeping the buckets for reuse.
+    void clear()
+    {
+        while (!empty())
+        {
+            pop_back();
+        }
+    }
+
+    // Frees buckets without elements.
+    void shrink_to_fit()
+    {
+        if (empty())
+        {
+            release();
+            return;
+        }
+
+        const auto bucketCount = segment_count();
+        if (bucketCount < _header->bucketCount)
+        {
+            auto* header = allocateHeader(bucketCount);
+            for (size_t i = bucketCount; i < _header->bucketCount; ++i)
+            {
+                deallocateBucket(i);
+            }
+            replaceHeader(header, bucketCount);
+        }
+    }
+
+    // Destroys elements and frees all memory.
+    void release()
+    {
+        if (_header)
+        {
+            clear();
+            for (size_t i = 0U; i < _header->bucketCount; ++i)
+            {
+                deallocateBucket(i);
+            }
+            deallocateHeader(_header);
+            _header = nullptr;
+        }
+    }
+
+    void swap(SegmentedVector& other)
+    {
+        using std::swap;
+        swap(this->getAllocatorRef(), other.getAllocatorRef());
+        swap(_header, other._header);
+    }
+
+private:
+    // Bucket pointers follow the header.
+    struct Header
+    {
+        size_t size;
+        size_t bucketCount;
+    };
+
+    using Buckets = BucketLayout<T>;
+
+    using HeaderUnit = std::aligned_storage_t<sizeof(void*), alignof(Header)>;
+    using HeaderAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<HeaderUnit>;
+
+    static size_t getHeaderUnits(const size_t bucketCount)
+    {
+        return (sizeof(Header) + bucketCount * sizeof(T*) + sizeof(HeaderUnit) - 1U) / sizeof(HeaderUnit);
+    }
+
+    T** getBuckets() const
+    {
+        return reinterpret_cast<T**>(_header + 1);
+    }
+
+    // Header is reallocated for every bucket, which copies only pointers to buckets.
+    void addBucket()
+    {
+        const auto bucketCount = _header ? _header->bucketCount : 0U;
+        if (bucketCount == Buckets::MaxBucketCount)
+        {
+            VectorDetails::throwLengthError();
+        }
+
+        auto* header = allocateHeader(bucketCount + 1U);
+        try
+        {
+            reinterpret_cast<T**>(header + 1)[bucketCount] =
+                std::allocator_traits<Allocator>::allocate(this->getAllocatorRef(), Buckets::getBucketSize(bucketCount));
+        }
+        catch (...)
+        {
+            deallocateHeader(header, bucketCount + 1U);
+            throw;
+        }
+        replaceHeader(header, bucketCount + 1U);
+    }
+
+    Header* allocateHeader(const size_t bucketCount)
+    {
+        HeaderAllocator headerAllocator(this->getAllocatorRef());
+        return reinterpret_cast<Header*>(
+            std::allocator_traits<HeaderAllocator>::allocate(headerAllocator, getHeaderUnits(bucketCount)));
+    }
+
+    // Moves size and pointers to the first "bucketCount" buckets, if there are any, to the new header.
+    void replaceHeader(Header* header, const size_t bucketCount)
+    {
+        *header = {size(), bucketCount};
+        if (_header)
+        {
+            const auto count = std::min(bucketCount, _header->bucketCount);
+            std::copy(getBuckets(), getBuckets() + count, reinterpret_cast<T**>(header + 1));
+            deallocateHeader(_header);
+        }
+        _header = header;
+    }
+
+    void deallocateBucket(const size_t bucket)
+    {
+        std::allocator_traits<Allocator>::deallocate(
+            this->getAllocatorRef(), getBuckets()[bucket], Buckets::getBucketSize(bucket));
+    }
+
+    void deallocateHeader(Header* header)
+    {
+        deallocateHeader(header, header->bucketCount);
+    }
+
+    void deallocateHeader(Header* header, const size_t bucketCount)
+    {
+        HeaderAllocator headerAllocator(this->getAllocatorRef());
+        std::allocator_traits<HeaderAllocator>::deallocate(
+            headerAllocator, reinterpret_cast<HeaderUnit*>(header), getHeaderUnits(bucketCount));
+    }
+
+private:
+    Header* _header = nullptr;
+};
+
+template <typename T, typename Allocator>
+bool operator==(const SegmentedVector<T, Allocator>& lhs, const SegmentedVector<T, Allocator>& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Allocator>
+bool operator!=(const SegmentedVector<T, Allocator>& lhs, const SegmentedVector<T, Allocator>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+namespace pmr
+{
+template <typename T>
+using SegmentedVector = SCONE::SegmentedVector<T, PolymorphicAllocator<T>>;
+} // namespace pmr
+
+} // namespace SCONE
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace SCONE
+{
+// Contiguous part of a non-contiguous container, which may be passed to algorithms, e.g. SCONE::count.
+template <typename T>
+class Span final
+{
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+public:
+    Span(T* data, const size_t size)
+        : _data(data)
+        , _size(size)
+    {
+    }
+
+    T* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    T* begin() const
+    {
+        return _data;
+    }
+
+    T* end() const
+    {
+        return _data + _size;
+    }
+
+private:
+    T* _data;
+    size_t _size;
+};
+
+} // namespace SCONE
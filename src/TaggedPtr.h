@@ -1,33 +1,309 @@
 #pragma once
 
+#include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
 
 namespace SCONE
 {
+template <uint8_t LowBits, uint8_t HighBits>
+class AtomicTaggedPtr;
 
+// Pointer which keeps an integer tag in its unused bits: "LowBits" bits freed by alignment of the pointee and
+// "HighBits" top bits, which are zero for user space pointers on x86-64 and AArch64 (48-bit address space).
+// Assignment of a pointer resets the tag.
+template <uint8_t LowBits = 1U, uint8_t HighBits = 0U>
 class TaggedPtr final
 {
+    static_assert(LowBits < 8U, "Allocations aren't aligned enough for so many low bits");
+    static_assert(HighBits == 0U || (sizeof(uintptr_t) == 8U && HighBits <= 16U),
+                  "Only top 16 bits of 64-bit pointers are free");
+
+public:
+    static constexpr uint8_t LowTagBits = LowBits;
+    static constexpr uint8_t HighTagBits = HighBits;
+    static constexpr uint8_t TagBits = LowBits + HighBits;
+
 public:
     TaggedPtr() = default;
 
-    TaggedPtr(void* ptr);
-    TaggedPtr& operator=(void* ptr);
+    TaggedPtr(std::nullptr_t)
+    {
+    }
+
+    template <typename PtrType>
+    TaggedPtr(PtrType* ptr)
+    {
+        *this = ptr;
+    }
+
+    TaggedPtr& operator=(std::nullptr_t)
+    {
+        _ptr = 0U;
+        return *this;
+    }
+
+    // Alignment is checked at compile time for typed pointers and at run time for void pointers.
+    template <typename PtrType>
+    TaggedPtr& operator=(PtrType* ptr)
+    {
+        _ptr = 0U;
+        setPtr(ptr);
+        return *this;
+    }
+
+    // Changes pointer keeping the tag.
+    template <typename PtrType>
+    void setPtr(PtrType* ptr)
+    {
+        static_assert(alignof(std::conditional_t<std::is_void<PtrType>::value, std::max_align_t, PtrType>) >=
+                          (size_t(1U) << LowBits),
+                      "Pointee alignment doesn't leave enough low bits");
+
+        const auto value = reinterpret_cast<uintptr_t>(ptr);
+        assert(!(value & ~PtrMask));
+        _ptr = (_ptr & ~PtrMask) | value;
+    }
 
     template <typename PtrType>
     PtrType* getAs() const
     {
-        return reinterpret_cast<PtrType*>(_ptr & (~uintptr_t(1)));
+        return reinterpret_cast<PtrType*>(_ptr & PtrMask);
+    }
+
+    explicit operator bool() const
+    {
+        return _ptr & PtrMask;
+    }
+
+    bool hasFlag() const
+    {
+        static_assert(LowBits > 0U, "No low bits for flag");
+        return _ptr & 1U;
+    }
+
+    void setFlag(const bool value)
+    {
+        static_assert(LowBits > 0U, "No low bits for flag");
+        _ptr = (_ptr & ~uintptr_t(1U)) | uintptr_t(value);
+    }
+
+    uintptr_t getLowTag() const
+    {
+        return _ptr & LowMask;
     }
 
-    explicit operator bool() const;
+    void setLowTag(const uintptr_t value)
+    {
+        assert(value <= LowMask);
+        _ptr = (_ptr & ~LowMask) | value;
+    }
 
-    bool hasFlag() const;
-    void setFlag(const bool value);
+    uintptr_t getHighTag() const
+    {
+        return HighBits ? (_ptr & HighMask) >> HighShift : 0U;
+    }
 
-    void swap(TaggedPtr& other);
+    void setHighTag(const uintptr_t value)
+    {
+        assert(value <= (HighMask >> HighShift));
+        _ptr = HighBits ? (_ptr & ~HighMask) | (value << HighShift) : _ptr;
+    }
+
+    // Tag of TagBits bits: low bits of the value are kept in low bits of the pointer, the rest in high bits.
+    uintptr_t getTag() const
+    {
+        return getLowTag() | (getHighTag() << LowBits);
+    }
+
+    void setTag(const uintptr_t value)
+    {
+        setLowTag(value & LowMask);
+        setHighTag(value >> LowBits);
+    }
+
+    bool operator==(const TaggedPtr& other) const
+    {
+        return _ptr == other._ptr;
+    }
+
+    bool operator!=(const TaggedPtr& other) const
+    {
+        return !(*this == other);
+    }
+
+    void swap(TaggedPtr& other)
+    {
+        std::swap(_ptr, other._ptr);
+    }
+
+private:
+    friend class AtomicTaggedPtr<LowBits, HighBits>;
+
+    static constexpr uintptr_t LowMask = (uintptr_t(1U) << LowBits) - 1U;
+    // Shift is kept valid for HighBits == 0, the mask is empty then.
+    static constexpr size_t HighShift = sizeof(uintptr_t) * 8U - (HighBits ? HighBits : 1U);
+    static constexpr uintptr_t HighMask = HighBits ? ~uintptr_t(0U) << HighShift : 0U;
+    static constexpr uintptr_t PtrMask = ~(LowMask | HighMask);
+
+private:
+    uintptr_t _ptr = 0U;
+};
+
+template <uint8_t LowBits, uint8_t HighBits>
+constexpr uint8_t TaggedPtr<LowBits, HighBits>::LowTagBits;
+
+template <uint8_t LowBits, uint8_t HighBits>
+constexpr uint8_t TaggedPtr<LowBits, HighBits>::HighTagBits;
+
+template <uint8_t LowBits, uint8_t HighBits>
+constexpr uint8_t TaggedPtr<LowBits, HighBits>::TagBits;
+
+// TaggedPtr which is loaded, stored and exchanged atomically together with its tag, e.g. to publish a pointer
+// with a state flag to other threads.
+template <uint8_t LowBits = 1U, uint8_t HighBits = 0U>
+class AtomicTaggedPtr final
+{
+public:
+    using Ptr = TaggedPtr<LowBits, HighBits>;
+
+public:
+    AtomicTaggedPtr() = default;
+
+    AtomicTaggedPtr(const Ptr& ptr)
+        : _ptr(ptr._ptr)
+    {
+    }
+
+    AtomicTaggedPtr(const AtomicTaggedPtr&) = delete;
+    AtomicTaggedPtr& operator=(const AtomicTaggedPtr&) = delete;
+
+    Ptr load(const std::memory_order order = std::memory_order_seq_cst) const
+    {
+        Ptr result;
+        result._ptr = _ptr.load(order);
+        return result;
+    }
+
+    void store(const Ptr& ptr, const std::memory_order order = std::memory_order_seq_cst)
+    {
+        _ptr.store(ptr._ptr, order);
+    }
+
+    Ptr exchange(const Ptr& ptr, const std::memory_order order = std::memory_order_seq_cst)
+    {
+        Ptr result;
+        result._ptr = _ptr.exchange(ptr._ptr, order);
+        return result;
+    }
+
+    // Replaces the value if it equals "expected" in both pointer and tag, otherwise loads it into "expected".
+    bool compareExchange(Ptr& expected,
+                         const Ptr& desired,
+                         const std::memory_order success = std::memory_order_seq_cst,
+                         const std::memory_order failure = std::memory_order_seq_cst)
+    {
+        return _ptr.compare_exchange_strong(expected._ptr, desired._ptr, success, failure);
+    }
+
+    bool isLockFree() const
+    {
+        return _ptr.is_lock_free();
+    }
+
+private:
+    std::atomic<uintptr_t> _ptr{0U};
+};
+
+namespace TaggedPtrDetails
+{
+constexpr uint8_t getBitsCount(const size_t value)
+{
+    return value > 1U ? 1U + getBitsCount((value + 1U) / 2U) : 0U;
+}
+
+template <typename T, typename... Types>
+struct IndexOf;
+
+template <typename T, typename... Types>
+struct IndexOf<T, T, Types...> : std::integral_constant<size_t, 0U>
+{
+};
+
+template <typename T, typename Other, typename... Types>
+struct IndexOf<T, Other, Types...> : std::integral_constant<size_t, 1U + IndexOf<T, Types...>::value>
+{
+};
+} // namespace TaggedPtrDetails
+
+// Pointer to one of "Types", discriminated by low bits. All types must be aligned enough to keep the index.
+template <typename... Types>
+class TaggedPtrUnion final
+{
+public:
+    TaggedPtrUnion() = default;
+
+    TaggedPtrUnion(std::nullptr_t)
+    {
+    }
+
+    template <typename T>
+    TaggedPtrUnion(T* ptr)
+    {
+        *this = ptr;
+    }
+
+    template <typename T>
+    TaggedPtrUnion& operator=(T* ptr)
+    {
+        _ptr = ptr;
+        _ptr.setLowTag(getIndex<T>());
+        return *this;
+    }
+
+    TaggedPtrUnion& operator=(std::nullptr_t)
+    {
+        _ptr = nullptr;
+        return *this;
+    }
+
+    template <typename T>
+    bool is() const
+    {
+        return _ptr && _ptr.getLowTag() == getIndex<T>();
+    }
+
+    template <typename T>
+    T* get() const
+    {
+        assert(is<T>());
+        return _ptr.template getAs<T>();
+    }
+
+    // Returns nullptr if another type is kept.
+    template <typename T>
+    T* getIf() const
+    {
+        return is<T>() ? _ptr.template getAs<T>() : nullptr;
+    }
+
+    explicit operator bool() const
+    {
+        return static_cast<bool>(_ptr);
+    }
+
+private:
+    template <typename T>
+    static constexpr uintptr_t getIndex()
+    {
+        return TaggedPtrDetails::IndexOf<T, Types...>::value;
+    }
 
 private:
-    uintptr_t _ptr = 0;
+    TaggedPtr<TaggedPtrDetails::getBitsCount(sizeof...(Types))> _ptr;
 };
 
 } // namespace SCONE
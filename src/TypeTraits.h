@@ -0,0 +1,14 @@
+#pragma once
+
+#include <type_traits>
+
+namespace SCONE
+{
+// Moving an object of such a type to another address and forgetting the source is equivalent to memcpy.
+// Specialize it for user types (e.g. types which own heap memory through a raw pointer) to opt in.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T>
+{
+};
+
+} // namespace SCONE
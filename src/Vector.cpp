@@ -1,15 +1,140 @@
 #include "Vector.h"
 
+#include <cstring>
+#include <stdexcept>
+
 namespace SCONE
 {
-int8_t getHighestBit(size_t value)
+namespace VectorDetails
+{
+void throwLengthError()
+{
+    throw std::length_error("SCONE::Vector size exceeds max_size()");
+}
+
+namespace CompactCore
+{
+namespace
+{
+// Tiny header takes less space than the short one only if elements don't need 4-byte alignment.
+uintptr_t getTier(const size_t capacity, const StorageTraits& traits)
+{
+    if (traits.dataAlignment < alignof(uint32_t) && capacity <= std::numeric_limits<uint8_t>::max())
+    {
+        return 0U;
+    }
+    if (capacity <= std::numeric_limits<uint16_t>::max())
+    {
+        return 1U;
+    }
+    if (capacity <= std::numeric_limits<uint32_t>::max())
+    {
+        return 2U;
+    }
+    return 3U;
+}
+
+bool isLarge(const uintptr_t tier)
+{
+    return tier > 1U;
+}
+
+size_t getMaxCapacity(const uintptr_t tier)
+{
+    return tier < 3U ? (size_t(1U) << (8U << tier)) - 1U : std::numeric_limits<size_t>::max();
+}
+
+size_t getUnits(const uintptr_t tier, const size_t capacity, const StorageTraits& traits)
+{
+    const auto unitSize = getUnitSize(isLarge(tier), traits.dataAlignment);
+    const auto bytes = getDataOffset(tier, traits.dataAlignment) + capacity * traits.elementSize;
+    return (bytes + unitSize - 1U) / unitSize;
+}
+
+// Capacity which fits into the allocated units, limited by the header size type.
+size_t getCapacity(const uintptr_t tier, const size_t units, const StorageTraits& traits)
+{
+    const auto bytes = units * getUnitSize(isLarge(tier), traits.dataAlignment);
+    const auto capacity = (bytes - getDataOffset(tier, traits.dataAlignment)) / traits.elementSize;
+    return std::min(capacity, getMaxCapacity(tier));
+}
+
+void initHeader(Ptr& ptr, const uintptr_t tier, const size_t size, const size_t capacity)
+{
+    ptr.setLowTag(tier);
+    visitHeader(ptr, [size, capacity](auto* header) {
+        using SizeType = decltype(header->size);
+        header->size = static_cast<SizeType>(size);
+        header->capacity = static_cast<SizeType>(capacity);
+    });
+}
+
+void moveElements(const Ptr& ptr, const size_t oldOffset, const size_t offset, const size_t bytes)
+{
+    auto* const block = ptr.getAs<char>();
+    std::memmove(block + offset, block + oldOffset, bytes);
+}
+} // namespace
+
+void allocate(Ptr& ptr, const size_t capacity, const StorageTraits& traits, void* allocator)
+{
+    const auto tier = getTier(capacity, traits);
+    const auto allocation = traits.allocate(allocator, getUnits(tier, capacity, traits), isLarge(tier));
+    ptr = allocation.ptr;
+    initHeader(ptr, tier, 0U, getCapacity(tier, allocation.count, traits));
+}
+
+bool reallocate(Ptr& ptr, const size_t capacity, const StorageTraits& traits, void* allocator)
 {
-    int8_t result = -1;
-    while (value)
+    assert(ptr);
+    const auto oldTier = ptr.getLowTag();
+    const auto tier = getTier(capacity, traits);
+    if (!traits.reallocate ||
+        getUnitSize(isLarge(oldTier), traits.dataAlignment) != getUnitSize(isLarge(tier), traits.dataAlignment))
+    {
+        return false;
+    }
+
+    const auto size = getSize(ptr);
+    assert(capacity >= size);
+    const auto oldUnits = getUnits(oldTier, getCapacity(ptr), traits);
+    const auto oldOffset = getDataOffset(oldTier, traits.dataAlignment);
+    const auto offset = getDataOffset(tier, traits.dataAlignment);
+
+    const auto units = getUnits(tier, capacity, traits);
+    const auto bytes = size * traits.elementSize;
+
+    // Elements at the old offset may not fit into a block shrunk for a smaller header, so they're copied into
+    // a new block. The old block is kept intact until the allocation succeeds.
+    if (units * getUnitSize(isLarge(tier), traits.dataAlignment) < oldOffset + bytes)
     {
-        ++result;
-        value >>= 1;
+        const auto allocation = traits.allocate(allocator, units, isLarge(tier));
+        std::memcpy(static_cast<char*>(allocation.ptr) + offset, ptr.getAs<char>() + oldOffset, bytes);
+        traits.deallocate(allocator, ptr.getAs<void>(), oldUnits, isLarge(oldTier));
+        ptr = allocation.ptr;
+        initHeader(ptr, tier, size, getCapacity(tier, allocation.count, traits));
+        return true;
     }
-    return result;
+
+    // Elements are moved to their place in the new tier only after the block is resized, so a failed
+    // reallocation leaves the storage as it was.
+    const auto allocation = traits.reallocate(allocator, ptr.getAs<void>(), oldUnits, units, isLarge(tier));
+    ptr = allocation.ptr;
+    if (offset != oldOffset)
+    {
+        moveElements(ptr, oldOffset, offset, bytes);
+    }
+    initHeader(ptr, tier, size, getCapacity(tier, allocation.count, traits));
+    return true;
+}
+
+void deallocate(Ptr& ptr, const StorageTraits& traits, void* allocator)
+{
+    assert(ptr);
+    const auto tier = ptr.getLowTag();
+    traits.deallocate(allocator, ptr.getAs<void>(), getUnits(tier, getCapacity(ptr), traits), isLarge(tier));
+    ptr = nullptr;
 }
+} // namespace CompactCore
+} // namespace VectorDetails
 } // namespace SCONE
@@ -1,15 +1,27 @@
 #pragma once
 
+#include "AlignedAllocator.h"
+#include "Algorithms.h"
+#include "AllocatorTraits.h"
+#include "GrowthPolicy.h"
+#include "MemoryResource.h"
+#include "OverflowPolicy.h"
 #include "TaggedPtr.h"
+#include "TypeTraits.h"
 #include "VectorFwd.h"
 
 #include <cassert>
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
 
 namespace SCONE
 {
-int8_t getHighestBit(size_t value);
-
 namespace VectorDetails
 {
 namespace StorageDetails
@@ -28,31 +40,191 @@ void destroy(Iterator it, const Iterator& end)
         destroy(*it);
     }
 }
-} // namespace StorageDetails
 
+// Moves [first, end) to "result" for trivially relocatable types. Ranges may overlap.
 template <typename T>
-class MemoryOptimizedStorage final
+void relocate(T* first, T* end, T* result)
+{
+    static_assert(IsTriviallyRelocatable<T>::value, "Type must be trivially relocatable");
+    if (first != end)
+    {
+        std::memmove(static_cast<void*>(result), static_cast<const void*>(first), (end - first) * sizeof(T));
+    }
+}
+
+// Keeps allocator using empty base optimization, so stateless allocators don't increase storage size.
+template <typename Allocator, bool = std::is_empty<Allocator>::value && !std::is_final<Allocator>::value>
+class AllocatorHolder : private Allocator
+{
+public:
+    explicit AllocatorHolder(const Allocator& allocator)
+        : Allocator(allocator)
+    {
+    }
+
+    Allocator& getAllocatorRef()
+    {
+        return *this;
+    }
+
+    const Allocator& getAllocatorRef() const
+    {
+        return *this;
+    }
+};
+
+template <typename Allocator>
+class AllocatorHolder<Allocator, false>
+{
+public:
+    explicit AllocatorHolder(const Allocator& allocator)
+        : _allocator(allocator)
+    {
+    }
+
+    Allocator& getAllocatorRef()
+    {
+        return _allocator;
+    }
+
+    const Allocator& getAllocatorRef() const
+    {
+        return _allocator;
+    }
+
+private:
+    Allocator _allocator;
+};
+} // namespace StorageDetails
+
+// Storages may define OverflowPolicy, by default vectors throw std::length_error on overflow.
+template <typename StorageType, typename = void>
+struct StorageOverflowPolicy
+{
+    using type = ThrowOnOverflow;
+};
+
+template <typename StorageType>
+struct StorageOverflowPolicy<StorageType, decltype(void(std::declval<typename StorageType::OverflowPolicy>()))>
+{
+    using type = typename StorageType::OverflowPolicy;
+};
+
+// Non-template part of MemoryOptimizedStorage, which depends only on element size and alignment and is compiled once
+// in Vector.cpp for all element types. A block starts with a header of size and capacity fields, which take 2^tier
+// bytes each, and the tier is kept in the pointer tag. Elements follow the header at the data alignment.
+namespace CompactCore
+{
+using Ptr = TaggedPtr<2U>;
+
+template <typename SizeType>
+struct Header final
+{
+    SizeType size;
+    SizeType capacity;
+};
+
+// Calls "function" with pointer to the header of the block.
+template <typename Function>
+decltype(auto) visitHeader(const Ptr& ptr, Function&& function)
+{
+    assert(ptr);
+    switch (ptr.getLowTag())
+    {
+    case 0U:
+        return function(ptr.getAs<Header<uint8_t>>());
+    case 1U:
+        return function(ptr.getAs<Header<uint16_t>>());
+    case 2U:
+        return function(ptr.getAs<Header<uint32_t>>());
+    default:
+        return function(ptr.getAs<Header<uint64_t>>());
+    }
+}
+
+inline size_t getSize(const Ptr& ptr)
+{
+    return visitHeader(ptr, [](const auto* header) -> size_t { return header->size; });
+}
+
+inline size_t getCapacity(const Ptr& ptr)
+{
+    return visitHeader(ptr, [](const auto* header) -> size_t { return header->capacity; });
+}
+
+inline void advanceSize(const Ptr& ptr, const ptrdiff_t value)
+{
+    visitHeader(ptr, [value](auto* header) { header->size += value; });
+}
+
+constexpr size_t getDataOffset(const uintptr_t tier, const size_t alignment)
+{
+    return ((size_t(2U) << tier) + alignment - 1U) / alignment * alignment;
+}
+
+// Blocks are requested in units of header alignment, so any allocator returns properly aligned memory.
+// Tiny and short blocks use 4-byte units to keep rounding low, long and huge blocks share 8-byte units,
+// so they can be resized into each other in place.
+constexpr size_t getUnitSize(const bool large, const size_t alignment)
 {
+    return alignment > (large ? 8U : 4U) ? alignment : (large ? 8U : 4U);
+}
+
+// Element type and allocator of a storage, with the allocator type erased. "large" selects the unit size.
+struct StorageTraits final
+{
+    size_t elementSize;
+    // Alignment of the element array, which may exceed alignment of the elements.
+    size_t dataAlignment;
+    AllocationResult<void*> (*allocate)(void* allocator, size_t units, bool large);
+    void (*deallocate)(void* allocator, void* block, size_t units, bool large);
+    // Null if the allocator can't resize blocks.
+    AllocationResult<void*> (*reallocate)(void* allocator, void* block, size_t oldUnits, size_t units, bool large);
+};
+
+// Allocates block of the smallest tier which can keep "capacity" elements.
+void allocate(Ptr& ptr, size_t capacity, const StorageTraits& traits, void* allocator);
+
+// Grows or shrinks the block moving elements bytewise, possibly to another tier.
+// Returns false if the allocator can't resize blocks or the tiers use different units.
+bool reallocate(Ptr& ptr, size_t capacity, const StorageTraits& traits, void* allocator);
+
+// Deallocates the block, elements must be destroyed by the caller.
+void deallocate(Ptr& ptr, const StorageTraits& traits, void* allocator);
+} // namespace CompactCore
+
+// Allocators are propagated on move and swap.
+template <typename T, typename Allocator, size_t Alignment>
+class MemoryOptimizedStorage final : private StorageDetails::AllocatorHolder<Allocator>
+{
+    static_assert(Alignment && !(Alignment & (Alignment - 1U)), "Alignment must be a power of two");
+
 public :
     using value_type = T;
+    using allocator_type = Allocator;
 
 public:
-    MemoryOptimizedStorage() = default;
+    explicit MemoryOptimizedStorage(const Allocator& allocator = Allocator())
+        : StorageDetails::AllocatorHolder<Allocator>(allocator)
+    {
+    }
 
     MemoryOptimizedStorage(const MemoryOptimizedStorage&) = delete;
     MemoryOptimizedStorage& operator =(const MemoryOptimizedStorage&) = delete;
 
-    MemoryOptimizedStorage(MemoryOptimizedStorage&& other)
+    MemoryOptimizedStorage(MemoryOptimizedStorage&& other) noexcept(std::is_nothrow_copy_constructible<Allocator>::value)
+        : MemoryOptimizedStorage(other.getAllocator())
     {
-        *this = std::move(other);
+        _ptr.swap(other._ptr);
     }
 
     MemoryOptimizedStorage& operator=(MemoryOptimizedStorage&& other) noexcept
     {
         if (this != &other)
         {
-            std::swap(_ptr, other._ptr);
-            other.free();
+            free();
+            this->getAllocatorRef() = other.getAllocator();
+            _ptr.swap(other._ptr);
         }
         return *this;
     }
@@ -65,24 +237,212 @@ public:
     void allocate(const size_t capacity)
     {
         assert(!_ptr);
-        if (capacity <= std::numeric_limits<typename ShortData::Size>::max())
+        CompactCore::allocate(_ptr, capacity, getTraits(), &this->getAllocatorRef());
+    }
+
+    // Grows or shrinks the buffer moving elements bytewise, so it may only be used for trivially relocatable types.
+    // Returns false if the allocator can't resize blocks, in which case the caller must move elements itself.
+    bool reallocate(const size_t capacity)
+    {
+        return _ptr && CompactCore::reallocate(_ptr, capacity, getTraits(), &this->getAllocatorRef());
+    }
+
+    void free()
+    {
+        if (_ptr)
+        {
+            auto* it = data();
+            StorageDetails::destroy(it, it + size());
+            CompactCore::deallocate(_ptr, getTraits(), &this->getAllocatorRef());
+        }
+    }
+
+    size_t size() const
+    {
+        return _ptr ? CompactCore::getSize(_ptr) : 0U;
+    }
+
+    size_t capacity() const
+    {
+        return _ptr ? CompactCore::getCapacity(_ptr) : 0U;
+    }
+
+    // Byte size of the largest block must fit into ptrdiff_t.
+    static size_t maxSize()
+    {
+        return (std::numeric_limits<ptrdiff_t>::max() - CompactCore::getDataOffset(3U, DataAlignment)) / sizeof(T);
+    }
+
+    T* data() const
+    {
+        return _ptr ? reinterpret_cast<T*>(_ptr.getAs<char>() + CompactCore::getDataOffset(_ptr.getLowTag(), DataAlignment))
+                    : nullptr;
+    }
+
+    void advanceSize(ptrdiff_t value)
+    {
+        CompactCore::advanceSize(_ptr, value);
+    }
+
+    void swap(MemoryOptimizedStorage& other)
+    {
+        using std::swap;
+        swap(this->getAllocatorRef(), other.getAllocatorRef());
+        _ptr.swap(other._ptr);
+    }
+
+    const Allocator& getAllocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
+private:
+    static constexpr size_t DataAlignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    template <bool Large>
+    using AllocationUnit = std::aligned_storage_t<CompactCore::getUnitSize(Large, DataAlignment),
+                                                  CompactCore::getUnitSize(Large, DataAlignment)>;
+
+    template <bool Large>
+    using UnitAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<AllocationUnit<Large>>;
+
+    static const CompactCore::StorageTraits& getTraits()
+    {
+        static constexpr CompactCore::StorageTraits traits = {
+            sizeof(T), DataAlignment, &allocateUnits, &deallocateUnits, getReallocateUnits(HasReallocate<UnitAllocator<true>>())};
+        return traits;
+    }
+
+    static AllocationResult<void*> allocateUnits(void* allocator, const size_t units, const bool large)
+    {
+        return large ? allocateUnits<true>(allocator, units) : allocateUnits<false>(allocator, units);
+    }
+
+    template <bool Large>
+    static AllocationResult<void*> allocateUnits(void* allocator, const size_t units)
+    {
+        UnitAllocator<Large> unitAllocator(*static_cast<Allocator*>(allocator));
+        const auto allocation = allocateAtLeast(unitAllocator, units);
+        return {allocation.ptr, allocation.count};
+    }
+
+    static void deallocateUnits(void* allocator, void* block, const size_t units, const bool large)
+    {
+        large ? deallocateUnits<true>(allocator, block, units) : deallocateUnits<false>(allocator, block, units);
+    }
+
+    template <bool Large>
+    static void deallocateUnits(void* allocator, void* block, const size_t units)
+    {
+        UnitAllocator<Large> unitAllocator(*static_cast<Allocator*>(allocator));
+        std::allocator_traits<UnitAllocator<Large>>::deallocate(
+            unitAllocator, static_cast<AllocationUnit<Large>*>(block), units);
+    }
+
+    using ReallocateUnits = AllocationResult<void*> (*)(void*, void*, size_t, size_t, bool);
+
+    static constexpr ReallocateUnits getReallocateUnits(std::false_type)
+    {
+        return nullptr;
+    }
+
+    static constexpr ReallocateUnits getReallocateUnits(std::true_type)
+    {
+        return &reallocateUnits;
+    }
+
+    static AllocationResult<void*> reallocateUnits(
+        void* allocator, void* block, const size_t oldUnits, const size_t units, const bool large)
+    {
+        return large ? reallocateUnits<true>(allocator, block, oldUnits, units)
+                     : reallocateUnits<false>(allocator, block, oldUnits, units);
+    }
+
+    template <bool Large>
+    static AllocationResult<void*> reallocateUnits(void* allocator, void* block, const size_t oldUnits, const size_t units)
+    {
+        UnitAllocator<Large> unitAllocator(*static_cast<Allocator*>(allocator));
+        const auto allocation = unitAllocator.reallocate(static_cast<AllocationUnit<Large>*>(block), oldUnits, units);
+        return {allocation.ptr, allocation.count};
+    }
+
+private:
+    CompactCore::Ptr _ptr;
+};
+
+// Keeps size and capacity of small buffers in the top 16 bits of the pointer, so size queries don't touch the heap
+// and small buffers have no header. Capacity of a small buffer is a power of two up to MaxSmallCapacity,
+// larger buffers fall back to a heap header. Requires 64-bit pointers with free top bits.
+// Allocators are propagated on move and swap.
+template <typename T, typename Allocator>
+class TaggedSizeStorage final : private StorageDetails::AllocatorHolder<Allocator>
+{
+    static_assert(sizeof(void*) == 8U, "Top bits of pointers are free only on 64-bit platforms");
+
+public :
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    static constexpr uint8_t MaxSmallCapacityClass = 11U;
+    static constexpr size_t MaxSmallCapacity = size_t(1U) << MaxSmallCapacityClass;
+
+public:
+    explicit TaggedSizeStorage(const Allocator& allocator = Allocator())
+        : StorageDetails::AllocatorHolder<Allocator>(allocator)
+    {
+    }
+
+    TaggedSizeStorage(const TaggedSizeStorage&) = delete;
+    TaggedSizeStorage& operator =(const TaggedSizeStorage&) = delete;
+
+    TaggedSizeStorage(TaggedSizeStorage&& other) noexcept(std::is_nothrow_copy_constructible<Allocator>::value)
+        : TaggedSizeStorage(other.getAllocator())
+    {
+        _ptr.swap(other._ptr);
+    }
+
+    TaggedSizeStorage& operator=(TaggedSizeStorage&& other) noexcept
+    {
+        if (this != &other)
+        {
+            free();
+            this->getAllocatorRef() = other.getAllocator();
+            _ptr.swap(other._ptr);
+        }
+        return *this;
+    }
+
+    ~TaggedSizeStorage()
+    {
+        free();
+    }
+
+    void allocate(const size_t capacity)
+    {
+        assert(!_ptr);
+        UnitAllocator allocator(this->getAllocatorRef());
+        if (capacity <= MaxSmallCapacity)
         {
-            _ptr = operator new(sizeof(ShortData) + (capacity - 1U) * sizeof(T));
-            auto* ptr = _ptr.getAs<ShortData>();
-            ptr->capacity = static_cast<typename ShortData::Size>(capacity);
-            ptr->size = 0U;
+            const auto capacityClass = getCapacityClass(capacity);
+            _ptr = UnitAllocatorTraits::allocate(allocator, getSmallUnits(capacityClass));
+            setSmallTag(0U, capacityClass);
         }
         else
         {
-            _ptr = operator new(sizeof(LongData) + (capacity - 1U) * sizeof(T));
+            const auto allocation = allocateAtLeast(allocator, getLargeUnits(capacity));
+            _ptr = allocation.ptr;
             _ptr.setFlag(true);
-
-            auto* ptr = _ptr.getAs<LongData>();
-            ptr->capacity = static_cast<typename LongData::Size>(capacity);
-            ptr->size = 0U;
+            initHeader(0U, allocation.count);
         }
     }
 
+    // Grows or shrinks the buffer moving elements bytewise, so it may only be used for trivially relocatable types.
+    // Returns false if the allocator can't resize blocks, in which case the caller must move elements itself.
+    bool reallocate(const size_t capacity)
+    {
+        return reallocate(capacity, HasReallocate<UnitAllocator>());
+    }
+
     void free()
     {
         if (_ptr)
@@ -90,62 +450,186 @@ public:
             auto* it = data();
             StorageDetails::destroy(it, it + size());
 
-            operator delete(_ptr.getAs<void>());
+            const auto units = _ptr.hasFlag() ? getLargeUnits(capacity()) : getSmallUnits(getSmallCapacityClass());
+            UnitAllocator allocator(this->getAllocatorRef());
+            UnitAllocatorTraits::deallocate(allocator, _ptr.getAs<AllocationUnit>(), units);
             _ptr = nullptr;
         }
     }
 
     uint32_t size() const
     {
-        return _ptr ? (_ptr.hasFlag() ? _ptr.getAs<LongData>()->size : _ptr.getAs<ShortData>()->size) : 0U;
+        return _ptr.hasFlag() ? _ptr.getAs<Data>()->size : static_cast<uint32_t>(_ptr.getHighTag() & SizeMask);
     }
 
     uint32_t capacity() const
     {
-        return _ptr ? (_ptr.hasFlag() ? _ptr.getAs<LongData>()->capacity : _ptr.getAs<ShortData>()->capacity) : 0U;
+        return _ptr ? (_ptr.hasFlag() ? _ptr.getAs<Data>()->capacity : uint32_t(1U) << getSmallCapacityClass()) : 0U;
+    }
+
+    static size_t maxSize()
+    {
+        return std::min<size_t>(std::numeric_limits<uint32_t>::max(), std::numeric_limits<ptrdiff_t>::max() / sizeof(T));
     }
 
     T* data() const
     {
-        return _ptr ? (_ptr.hasFlag() ? _ptr.getAs<LongData>()->data : _ptr.getAs<ShortData>()->data) : nullptr;
+        return _ptr.hasFlag() ? _ptr.getAs<Data>()->data : _ptr.getAs<T>();
     }
 
     void advanceSize(ptrdiff_t value)
     {
-        _ptr.hasFlag() ? _ptr.getAs<LongData>()->size += value : _ptr.getAs<ShortData>()->size += value;
+        if (_ptr.hasFlag())
+        {
+            _ptr.getAs<Data>()->size += value;
+        }
+        else
+        {
+            // Size is kept in the lowest bits of the tag.
+            _ptr.setHighTag(_ptr.getHighTag() + value);
+        }
+        assert(size() <= capacity());
     }
 
-    void swap(MemoryOptimizedStorage& other)
+    void swap(TaggedSizeStorage& other)
     {
+        using std::swap;
+        swap(this->getAllocatorRef(), other.getAllocatorRef());
         _ptr.swap(other._ptr);
     }
 
+    const Allocator& getAllocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
 private:
-    template <typename SizeType>
     struct Data final
     {
-        using Size = SizeType;
-
-        SizeType size;
-        SizeType capacity;
+        uint32_t size;
+        uint32_t capacity;
         T data[1];
     };
 
-    using LongData = Data<uint32_t>;
-    using ShortData = Data<uint16_t>;
+    using AllocationUnit = std::aligned_storage_t<alignof(Data), alignof(Data)>;
+    using UnitAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<AllocationUnit>;
+    using UnitAllocatorTraits = std::allocator_traits<UnitAllocator>;
+
+    // Layout of the high tag: size in the lowest bits, capacity class above it.
+    static constexpr uint8_t SizeBits = 12U;
+    static constexpr uintptr_t SizeMask = (uintptr_t(1U) << SizeBits) - 1U;
+
+    static_assert(MaxSmallCapacity <= SizeMask, "Size of small buffer must fit into the tag");
+
+    static uint8_t getCapacityClass(const size_t capacity)
+    {
+        return static_cast<uint8_t>(getHighestBit(capacity - 1U) + 1);
+    }
+
+    static size_t getSmallUnits(const uint8_t capacityClass)
+    {
+        const auto bytes = (size_t(1U) << capacityClass) * sizeof(T);
+        return (bytes + sizeof(AllocationUnit) - 1U) / sizeof(AllocationUnit);
+    }
+
+    static size_t getLargeUnits(const size_t capacity)
+    {
+        const auto bytes = sizeof(Data) + (capacity - 1U) * sizeof(T);
+        return (bytes + sizeof(AllocationUnit) - 1U) / sizeof(AllocationUnit);
+    }
+
+    uint8_t getSmallCapacityClass() const
+    {
+        return static_cast<uint8_t>(_ptr.getHighTag() >> SizeBits);
+    }
+
+    void setSmallTag(const size_t size, const uint8_t capacityClass)
+    {
+        _ptr.setHighTag(size | (uintptr_t(capacityClass) << SizeBits));
+    }
+
+    void initHeader(const size_t size, const size_t units)
+    {
+        auto* ptr = _ptr.getAs<Data>();
+        const auto capacity = (units * sizeof(AllocationUnit) - sizeof(Data)) / sizeof(T) + 1U;
+        ptr->capacity = static_cast<uint32_t>(std::min<size_t>(capacity, std::numeric_limits<uint32_t>::max()));
+        ptr->size = static_cast<uint32_t>(size);
+    }
+
+    bool reallocate(const size_t, std::false_type)
+    {
+        return false;
+    }
+
+    bool reallocate(const size_t capacity, std::true_type)
+    {
+        if (!_ptr)
+        {
+            return false;
+        }
+
+        const auto size = this->size();
+        assert(capacity >= size);
+        const auto oldOffset = reinterpret_cast<char*>(data()) - _ptr.getAs<char>();
+        const auto oldUnits = _ptr.hasFlag() ? getLargeUnits(this->capacity()) : getSmallUnits(getSmallCapacityClass());
+
+        UnitAllocator allocator(this->getAllocatorRef());
+        if (capacity <= MaxSmallCapacity)
+        {
+            const auto capacityClass = getCapacityClass(capacity);
+            const auto units = getSmallUnits(capacityClass);
+            const auto bytes = size * sizeof(T);
+            // Elements of a large buffer are moved to the start of the block after it is shrunk to a small one,
+            // unless they don't fit into it at their old place. Then they're copied into a new block, so that
+            // the old one is kept intact until the allocation succeeds.
+            if (units * sizeof(AllocationUnit) < oldOffset + bytes)
+            {
+                auto* block = UnitAllocatorTraits::allocate(allocator, units);
+                std::memcpy(static_cast<void*>(block), data(), bytes);
+                UnitAllocatorTraits::deallocate(allocator, _ptr.getAs<AllocationUnit>(), oldUnits);
+                _ptr = block;
+            }
+            else
+            {
+                _ptr = allocator.reallocate(_ptr.getAs<AllocationUnit>(), oldUnits, units).ptr;
+                if (oldOffset)
+                {
+                    std::memmove(_ptr.getAs<void>(), _ptr.getAs<char>() + oldOffset, bytes);
+                }
+            }
+            setSmallTag(size, capacityClass);
+        }
+        else
+        {
+            const auto allocation = allocator.reallocate(_ptr.getAs<AllocationUnit>(), oldUnits, getLargeUnits(capacity));
+            _ptr = allocation.ptr;
+            _ptr.setFlag(true);
+
+            auto* const block = _ptr.getAs<char>();
+            std::memmove(static_cast<void*>(_ptr.getAs<Data>()->data), block + oldOffset, size * sizeof(T));
+            initHeader(size, allocation.count);
+        }
+        return true;
+    }
 
 private:
-    TaggedPtr _ptr;
+    TaggedPtr<1U, 16U> _ptr;
 };
 
-template <typename T, uint32_t InlineSize>
-class InlineStorage final
+// Heap buffers are aligned to "Alignment", inline elements keep their natural alignment.
+// Allocators are propagated on move and swap.
+template <typename T, uint32_t InlineSize, typename Allocator, size_t Alignment>
+class InlineStorage final : private StorageDetails::AllocatorHolder<Allocator>
 {
+    static_assert(Alignment && !(Alignment & (Alignment - 1U)), "Alignment must be a power of two");
+
 public :
     using value_type = T;
+    using allocator_type = Allocator;
 
 public:
-    InlineStorage()
+    explicit InlineStorage(const Allocator& allocator = Allocator())
+        : StorageDetails::AllocatorHolder<Allocator>(allocator)
     {
         init();
     }
@@ -154,7 +638,7 @@ public:
     InlineStorage& operator =(const InlineStorage&) = delete;
 
     InlineStorage(InlineStorage&& other) noexcept(std::is_nothrow_move_assignable<InlineStorage>::value)
-        : InlineStorage()
+        : InlineStorage(other.getAllocator())
     {
         *this = std::move(other);
     }
@@ -164,18 +648,11 @@ public:
         if (this != &other)
         {
             free();
+            this->getAllocatorRef() = other.getAllocator();
             _capacity = other._capacity;
             if (other.isInline())
             {
-                // TODO: Optimize for POD types and unite with Vector::moveData.
-                auto* it = other.data();
-                const auto endIt = it + other._size;
-                for (auto dataIt = data(); it != endIt; ++it, ++dataIt)
-                {
-                    new (dataIt) T(std::move(*it));
-                    ++_size;
-                }
-                other.free();
+                moveInlineData(other, IsTriviallyRelocatable<T>());
             }
             else
             {
@@ -198,20 +675,29 @@ public:
         assert(isInline() && _size == 0U);
         if (capacity > InlineSize)
         {
-            _capacity = static_cast<uint32_t>(capacity);
-            getHeapDataPtrRef() = operator new(_capacity * sizeof(T));
+            HeapAllocator allocator(this->getAllocatorRef());
+            const auto allocation = allocateAtLeast(allocator, getUnits(capacity));
+            _capacity = getCapacity(allocation.count);
+            getHeapDataPtrRef() = allocation.ptr;
         }
     }
 
+    // Grows or shrinks the heap buffer moving elements bytewise, so it may only be used for trivially relocatable types.
+    // Returns false if data is or would be inline or the allocator can't resize blocks.
+    bool reallocate(const size_t capacity)
+    {
+        return reallocate(capacity, HasReallocate<HeapAllocator>());
+    }
+
     void free()
     {
         auto* it = data();
-        auto* const ptr = (void*)it;
         StorageDetails::destroy(it, it + _size);
 
         if (!isInline())
         {
-            operator delete(ptr);
+            HeapAllocator allocator(this->getAllocatorRef());
+            HeapAllocatorTraits::deallocate(allocator, reinterpret_cast<HeapUnit*>(it), getUnits(_capacity));
         }
         init();
     }
@@ -226,9 +712,14 @@ public:
         return _capacity;
     }
 
-    const T* data() const
+    static size_t maxSize()
     {
-        return data(*this);
+        return std::min<size_t>(std::numeric_limits<uint32_t>::max(), std::numeric_limits<ptrdiff_t>::max() / sizeof(T));
+    }
+
+    const T* data() const
+    {
+        return data(*this);
     }
 
     T* data()
@@ -252,18 +743,81 @@ public:
         }
         else
         {
+            using std::swap;
+            swap(this->getAllocatorRef(), other.getAllocatorRef());
             std::swap(_capacity, other._capacity);
             std::swap(_size, other._size);
             std::swap(getHeapDataPtrRef(), other.getHeapDataPtrRef());
         }
     }
 
+    const Allocator& getAllocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
 private:
+    // Over-aligned heap buffers are allocated in units of the alignment.
+    using HeapUnit = std::conditional_t<(Alignment > alignof(T)), std::aligned_storage_t<Alignment, Alignment>, T>;
+    using HeapAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<HeapUnit>;
+    using HeapAllocatorTraits = std::allocator_traits<HeapAllocator>;
+
     bool isInline() const
     {
         return capacity() == InlineSize;
     }
 
+    bool reallocate(const size_t, std::false_type)
+    {
+        return false;
+    }
+
+    bool reallocate(const size_t capacity, std::true_type)
+    {
+        if (isInline() || capacity <= InlineSize)
+        {
+            return false;
+        }
+
+        HeapAllocator allocator(this->getAllocatorRef());
+        auto*& ptr = getHeapDataPtrRef();
+        const auto allocation =
+            allocator.reallocate(static_cast<HeapUnit*>(ptr), getUnits(_capacity), getUnits(capacity));
+        ptr = allocation.ptr;
+        _capacity = getCapacity(allocation.count);
+        return true;
+    }
+
+    static size_t getUnits(const size_t capacity)
+    {
+        return (capacity * sizeof(T) + sizeof(HeapUnit) - 1U) / sizeof(HeapUnit);
+    }
+
+    static uint32_t getCapacity(const size_t units)
+    {
+        const auto capacity = units * sizeof(HeapUnit) / sizeof(T);
+        return static_cast<uint32_t>(std::min<size_t>(capacity, std::numeric_limits<uint32_t>::max()));
+    }
+
+    void moveInlineData(InlineStorage& other, std::true_type)
+    {
+        StorageDetails::relocate(other.data(), other.data() + other._size, data());
+        _size = other._size;
+        other.init();
+    }
+
+    void moveInlineData(InlineStorage& other, std::false_type)
+    {
+        auto* it = other.data();
+        const auto endIt = it + other._size;
+        for (auto dataIt = data(); it != endIt; ++it, ++dataIt)
+        {
+            new (dataIt) T(std::move(*it));
+            ++_size;
+        }
+        other.free();
+    }
+
     void init()
     {
         _capacity = InlineSize;
@@ -295,233 +849,1419 @@ private:
     std::aligned_storage_t<getMax(sizeof(T[InlineSize]), sizeof(T*)), getMax(alignof(T), alignof(T*))> _union;
 };
 
-} // namespace VectorDetails
+// Inline storage which takes exactly "Size" bytes: inline elements use all of them but the last byte, which keeps
+// the inline size or marks heap mode. In heap mode pointer, size and capacity are kept at the start of the buffer.
+// Allocators are propagated on move and swap.
+template <typename T, size_t Size, typename Allocator>
+class PackedInlineStorage final : private StorageDetails::AllocatorHolder<Allocator>
+{
+    struct HeapData
+    {
+        T* ptr;
+        uint32_t size;
+        uint32_t capacity;
+    };
 
-template <typename StorageType>
-class Vector final
+    static constexpr size_t BufferAlignment = std::max(alignof(T), alignof(HeapData));
+    static constexpr uint8_t HeapTag = std::numeric_limits<uint8_t>::max();
+
+    static_assert(Size % BufferAlignment == 0U, "Size must be a multiple of the element and pointer alignment");
+    static_assert(Size > sizeof(HeapData), "Size must exceed heap pointer, size and capacity");
+    static_assert(Size <= HeapTag, "Inline size must fit into one byte");
+
+public :
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    static constexpr uint32_t InlineSize = static_cast<uint32_t>((Size - 1U) / sizeof(T));
+    static_assert(InlineSize > 0U, "Size must fit at least one element");
+
+public:
+    explicit PackedInlineStorage(const Allocator& allocator = Allocator())
+        : StorageDetails::AllocatorHolder<Allocator>(allocator)
+    {
+        init();
+    }
+
+    PackedInlineStorage(const PackedInlineStorage&) = delete;
+    PackedInlineStorage& operator =(const PackedInlineStorage&) = delete;
+
+    PackedInlineStorage(PackedInlineStorage&& other) noexcept(std::is_nothrow_move_assignable<PackedInlineStorage>::value)
+        : PackedInlineStorage(other.getAllocator())
+    {
+        *this = std::move(other);
+    }
+
+    PackedInlineStorage& operator=(PackedInlineStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other)
+        {
+            free();
+            this->getAllocatorRef() = other.getAllocator();
+            if (other.isInline())
+            {
+                moveInlineData(other, IsTriviallyRelocatable<T>());
+            }
+            else
+            {
+                getHeapData() = other.getHeapData();
+                getTag() = HeapTag;
+                other.init();
+            }
+        }
+
+        return *this;
+    }
+
+    ~PackedInlineStorage()
+    {
+        free();
+    }
+
+    void allocate(const size_t capacity)
+    {
+        assert(isInline() && size() == 0U);
+        if (capacity > InlineSize)
+        {
+            const auto allocation = allocateAtLeast(this->getAllocatorRef(), capacity);
+            getHeapData() = {allocation.ptr, 0U, getCapacity(allocation.count)};
+            getTag() = HeapTag;
+        }
+    }
+
+    // Grows or shrinks the heap buffer moving elements bytewise, so it may only be used for trivially relocatable types.
+    // Returns false if data is or would be inline or the allocator can't resize blocks.
+    bool reallocate(const size_t capacity)
+    {
+        return reallocate(capacity, HasReallocate<Allocator>());
+    }
+
+    void free()
+    {
+        auto* it = data();
+        StorageDetails::destroy(it, it + size());
+
+        if (!isInline())
+        {
+            std::allocator_traits<Allocator>::deallocate(this->getAllocatorRef(), it, getHeapData().capacity);
+        }
+        init();
+    }
+
+    uint32_t size() const
+    {
+        return isInline() ? getTag() : getHeapData().size;
+    }
+
+    uint32_t capacity() const
+    {
+        return isInline() ? InlineSize : getHeapData().capacity;
+    }
+
+    static size_t maxSize()
+    {
+        return std::min<size_t>(std::numeric_limits<uint32_t>::max(), std::numeric_limits<ptrdiff_t>::max() / sizeof(T));
+    }
+
+    const T* data() const
+    {
+        return isInline() ? reinterpret_cast<const T*>(&_buffer) : getHeapData().ptr;
+    }
+
+    T* data()
+    {
+        return isInline() ? reinterpret_cast<T*>(&_buffer) : getHeapData().ptr;
+    }
+
+    void advanceSize(ptrdiff_t value)
+    {
+        if (isInline())
+        {
+            getTag() = static_cast<uint8_t>(getTag() + value);
+        }
+        else
+        {
+            getHeapData().size += value;
+        }
+        assert(size() <= capacity());
+    }
+
+    void swap(PackedInlineStorage& other)
+    {
+        if (isInline() || other.isInline())
+        {
+            PackedInlineStorage tmp = std::move(other);
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+        else
+        {
+            using std::swap;
+            swap(this->getAllocatorRef(), other.getAllocatorRef());
+            std::swap(getHeapData(), other.getHeapData());
+        }
+    }
+
+    const Allocator& getAllocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
+private:
+    bool isInline() const
+    {
+        return getTag() != HeapTag;
+    }
+
+    bool reallocate(const size_t, std::false_type)
+    {
+        return false;
+    }
+
+    bool reallocate(const size_t capacity, std::true_type)
+    {
+        if (isInline() || capacity <= InlineSize)
+        {
+            return false;
+        }
+
+        auto& heapData = getHeapData();
+        const auto allocation = this->getAllocatorRef().reallocate(heapData.ptr, heapData.capacity, capacity);
+        heapData.ptr = allocation.ptr;
+        heapData.capacity = getCapacity(allocation.count);
+        return true;
+    }
+
+    static uint32_t getCapacity(const size_t count)
+    {
+        return static_cast<uint32_t>(std::min<size_t>(count, std::numeric_limits<uint32_t>::max()));
+    }
+
+    void moveInlineData(PackedInlineStorage& other, std::true_type)
+    {
+        const auto otherSize = other.size();
+        StorageDetails::relocate(other.data(), other.data() + otherSize, data());
+        getTag() = static_cast<uint8_t>(otherSize);
+        other.init();
+    }
+
+    void moveInlineData(PackedInlineStorage& other, std::false_type)
+    {
+        auto* it = other.data();
+        const auto endIt = it + other.size();
+        for (auto dataIt = data(); it != endIt; ++it, ++dataIt)
+        {
+            new (dataIt) T(std::move(*it));
+            ++getTag();
+        }
+        other.free();
+    }
+
+    // Heap data is zeroed too, so that compilers don't see it read uninitialized in moves and swaps of empty storages.
+    void init()
+    {
+        getHeapData() = HeapData{};
+        getTag() = 0U;
+    }
+
+    uint8_t& getTag()
+    {
+        return reinterpret_cast<uint8_t*>(&_buffer)[Size - 1U];
+    }
+
+    uint8_t getTag() const
+    {
+        return reinterpret_cast<const uint8_t*>(&_buffer)[Size - 1U];
+    }
+
+    HeapData& getHeapData()
+    {
+        return *reinterpret_cast<HeapData*>(&_buffer);
+    }
+
+    const HeapData& getHeapData() const
+    {
+        return *reinterpret_cast<const HeapData*>(&_buffer);
+    }
+
+private:
+    std::aligned_storage_t<Size, BufferAlignment> _buffer;
+};
+
+template <typename T, size_t Size, typename Allocator>
+constexpr uint32_t PackedInlineStorage<T, Size, Allocator>::InlineSize;
+
+// Storage of at most "Capacity" elements, which are always kept inline. Size takes the smallest fitting type
+// and elements are accessed without checking where they are. Requests for more elements are handled
+// by "OverflowPolicy".
+template <typename T, uint32_t Capacity, typename OverflowPolicyType>
+class StaticStorage final
 {
+    static_assert(Capacity > 0U, "Capacity must be positive");
+
+    using SizeType = std::conditional_t<(Capacity <= std::numeric_limits<uint8_t>::max()),
+                                        uint8_t,
+                                        std::conditional_t<(Capacity <= std::numeric_limits<uint16_t>::max()),
+                                                           uint16_t,
+                                                           uint32_t>>;
+
+public :
+    using value_type = T;
+    // Never used to allocate, only keeps the container interface.
+    using allocator_type = std::allocator<T>;
+    using OverflowPolicy = OverflowPolicyType;
+
 public:
-    using value_type = typename StorageType::value_type;
-    using size_type = size_t;
-    using difference_type = std::ptrdiff_t;
+    explicit StaticStorage(const allocator_type& = allocator_type())
+    {
+    }
 
-    using reference = value_type&;
-    using const_reference = const value_type&;
-    using pointer = value_type*;
-    using const_pointer = const value_type*;
+    StaticStorage(const StaticStorage&) = delete;
+    StaticStorage& operator =(const StaticStorage&) = delete;
 
-    using iterator = pointer;
-    using const_iterator = const_pointer;
+    StaticStorage(StaticStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        moveData(other, IsTriviallyRelocatable<T>());
+    }
 
-    using reverse_iterator = std::reverse_iterator<iterator>;
-    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    StaticStorage& operator=(StaticStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if (this != &other)
+        {
+            free();
+            moveData(other, IsTriviallyRelocatable<T>());
+        }
+        return *this;
+    }
+
+    ~StaticStorage()
+    {
+        free();
+    }
+
+    void allocate(const size_t capacity)
+    {
+        assert(_size == 0U);
+        if (capacity > Capacity)
+        {
+            OverflowPolicy::onOverflow();
+        }
+    }
+
+    // Elements never need to move, any capacity up to maxSize() is already there.
+    bool reallocate(const size_t capacity)
+    {
+        assert(capacity <= Capacity);
+        (void)capacity;
+        return true;
+    }
+
+    void free()
+    {
+        StorageDetails::destroy(data(), data() + _size);
+        _size = 0U;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    static constexpr size_t capacity()
+    {
+        return Capacity;
+    }
+
+    static constexpr size_t maxSize()
+    {
+        return Capacity;
+    }
+
+    const T* data() const
+    {
+        return reinterpret_cast<const T*>(&_data);
+    }
+
+    T* data()
+    {
+        return reinterpret_cast<T*>(&_data);
+    }
+
+    void advanceSize(ptrdiff_t value)
+    {
+        _size = static_cast<SizeType>(_size + value);
+        assert(_size <= Capacity);
+    }
+
+    void swap(StaticStorage& other)
+    {
+        StaticStorage tmp = std::move(other);
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    allocator_type getAllocator() const
+    {
+        return allocator_type();
+    }
+
+private:
+    void moveData(StaticStorage& other, std::true_type)
+    {
+        StorageDetails::relocate(other.data(), other.data() + other._size, data());
+        _size = other._size;
+        other._size = 0U;
+    }
+
+    void moveData(StaticStorage& other, std::false_type)
+    {
+        auto* it = other.data();
+        const auto endIt = it + other._size;
+        for (auto dataIt = data(); it != endIt; ++it, ++dataIt)
+        {
+            new (dataIt) T(std::move(*it));
+            ++_size;
+        }
+        other.free();
+    }
+
+private:
+    std::aligned_storage_t<sizeof(T[Capacity]), alignof(T)> _data;
+    SizeType _size = 0U;
+};
+
+// Copy-on-write storage: copies share one block with a reference count in its header, so the container keeps
+// the one-pointer footprint of MemoryOptimizedStorage and is copied in O(1). Non-const data() copies elements
+// into an own block first if the block is shared, so references and iterators obtained from a shared vector
+// are invalidated by its first non-const access. Size is changed only after data() was taken.
+// Non-const data() also marks the block unshareable with a reference count sentinel, as references to its elements
+// may be kept and written through, so copies of a marked block copy elements. Vector restores shareability after
+// changes which hand out no references, e.g. push_back() or reserve(), see ShareableGuard.
+// Copies share the allocator, allocators are propagated on move and swap. Reference counting is thread-safe,
+// the same vector is not.
+template <typename T, typename Allocator>
+class SharedStorage final : private StorageDetails::AllocatorHolder<Allocator>
+{
+    struct Header
+    {
+        std::atomic<size_t> refCount;
+        size_t size;
+        size_t capacity;
+    };
+
+    static constexpr size_t UnitSize = alignof(T) > alignof(Header) ? alignof(T) : alignof(Header);
+    static constexpr size_t DataOffset = (sizeof(Header) + UnitSize - 1U) / UnitSize * UnitSize;
+    // Reference count of a block, whose elements may be referred to by the owner.
+    static constexpr size_t Unshareable = std::numeric_limits<size_t>::max();
+
+    using Unit = std::aligned_storage_t<UnitSize, UnitSize>;
+    using UnitAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Unit>;
+
+public :
+    using value_type = T;
+    using allocator_type = Allocator;
+
+public:
+    explicit SharedStorage(const Allocator& allocator = Allocator())
+        : StorageDetails::AllocatorHolder<Allocator>(allocator)
+    {
+    }
+
+    SharedStorage(const SharedStorage& other)
+        : SharedStorage(other.getAllocator())
+    {
+        if (!other._header)
+        {
+            return;
+        }
+
+        if (other.shareable())
+        {
+            other._header->refCount.fetch_add(1U, std::memory_order_relaxed);
+            _header = other._header;
+        }
+        else if (other._header->size > 0U)
+        {
+            _header = copyBlock(other, other._header->size);
+        }
+    }
+
+    SharedStorage& operator =(const SharedStorage&) = delete;
+
+    SharedStorage(SharedStorage&& other) noexcept
+        : SharedStorage(other.getAllocator())
+    {
+        std::swap(_header, other._header);
+    }
+
+    SharedStorage& operator=(SharedStorage&& other) noexcept
+    {
+        if (this != &other)
+        {
+            free();
+            this->getAllocatorRef() = other.getAllocator();
+            std::swap(_header, other._header);
+        }
+        return *this;
+    }
+
+    ~SharedStorage()
+    {
+        free();
+    }
+
+    void allocate(const size_t capacity)
+    {
+        assert(!_header);
+        _header = allocateHeader(capacity);
+    }
+
+    // A shared block is replaced by an own copy of "capacity" elements. Elements of an own block are moved by
+    // the caller.
+    bool reallocate(const size_t capacity)
+    {
+        if (!_header || unique())
+        {
+            return false;
+        }
+        detach(capacity);
+        return true;
+    }
+
+    // Drops the reference, the last one destroys elements and deallocates the block. Only the owner refers to an
+    // unshareable block.
+    void free()
+    {
+        if (_header)
+        {
+            if (_header->refCount.load(std::memory_order_relaxed) == Unshareable ||
+                _header->refCount.fetch_sub(1U, std::memory_order_acq_rel) == 1U)
+            {
+                StorageDetails::destroy(data(*this), data(*this) + _header->size);
+                deallocateHeader(_header);
+            }
+            _header = nullptr;
+        }
+    }
+
+    size_t size() const
+    {
+        return _header ? _header->size : 0U;
+    }
+
+    size_t capacity() const
+    {
+        return _header ? _header->capacity : 0U;
+    }
+
+    static size_t maxSize()
+    {
+        return (std::numeric_limits<ptrdiff_t>::max() - DataOffset) / sizeof(T);
+    }
+
+    const T* data() const
+    {
+        return data(*this);
+    }
+
+    T* data()
+    {
+        makeUnique();
+        if (_header && _header->refCount.load(std::memory_order_relaxed) != Unshareable)
+        {
+            _header->refCount.store(Unshareable, std::memory_order_relaxed);
+        }
+        return data(*this);
+    }
+
+    // Whether copies may share the block, i.e. no references to its elements were handed out.
+    bool shareable() const
+    {
+        return !_header || _header->refCount.load(std::memory_order_relaxed) != Unshareable;
+    }
+
+    // Called once references handed out by data() are no longer used.
+    void markShareable()
+    {
+        if (!shareable())
+        {
+            _header->refCount.store(1U, std::memory_order_relaxed);
+        }
+    }
+
+    // Callers take data() first, which makes the block unique.
+    void advanceSize(ptrdiff_t value)
+    {
+        assert(unique());
+        _header->size += value;
+    }
+
+    void swap(SharedStorage& other)
+    {
+        using std::swap;
+        swap(this->getAllocatorRef(), other.getAllocatorRef());
+        swap(_header, other._header);
+    }
+
+    const Allocator& getAllocator() const
+    {
+        return this->getAllocatorRef();
+    }
+
+    // Whether no other storage refers to the block. Only this storage may share it again, so the count can't grow
+    // concurrently. The load synchronizes with the release of other references, so that reads of the block by
+    // their owners happen before writes of this storage.
+    bool unique() const
+    {
+        if (!_header)
+        {
+            return true;
+        }
+        const auto refCount = _header->refCount.load(std::memory_order_acquire);
+        return refCount == 1U || refCount == Unshareable;
+    }
+
+    void makeUnique()
+    {
+        if (!unique())
+        {
+            detach(_header->capacity);
+        }
+    }
+
+private:
+    template <typename Self>
+    static auto data(Self& self)
+    {
+        return self._header ? reinterpret_cast<T*>(reinterpret_cast<char*>(self._header) + DataOffset) : nullptr;
+    }
+
+    static size_t getUnits(const size_t capacity)
+    {
+        return (DataOffset + capacity * sizeof(T) + UnitSize - 1U) / UnitSize;
+    }
+
+    Header* allocateHeader(const size_t capacity)
+    {
+        UnitAllocator allocator(this->getAllocatorRef());
+        auto* header =
+            reinterpret_cast<Header*>(std::allocator_traits<UnitAllocator>::allocate(allocator, getUnits(capacity)));
+        new (&header->refCount) std::atomic<size_t>(1U);
+        header->size = 0U;
+        header->capacity = capacity;
+        return header;
+    }
+
+    void deallocateHeader(Header* header)
+    {
+        UnitAllocator allocator(this->getAllocatorRef());
+        std::allocator_traits<UnitAllocator>::deallocate(
+            allocator, reinterpret_cast<Unit*>(header), getUnits(header->capacity));
+    }
+
+    // Copies elements of the shared block into an own block of "capacity" elements.
+    void detach(const size_t capacity)
+    {
+        auto* header = copyBlock(*this, capacity);
+        free();
+        _header = header;
+    }
+
+    // Copies elements of the block of "source" into a new block of "capacity" elements.
+    Header* copyBlock(const SharedStorage& source, const size_t capacity)
+    {
+        assert(capacity >= source._header->size);
+        auto* header = allocateHeader(capacity);
+        auto* target = reinterpret_cast<T*>(reinterpret_cast<char*>(header) + DataOffset);
+        try
+        {
+            copyData(data(source), data(source) + source._header->size, target, std::is_trivially_copyable<T>());
+        }
+        catch (...)
+        {
+            deallocateHeader(header);
+            throw;
+        }
+        header->size = source._header->size;
+        return header;
+    }
+
+    static void copyData(const T* first, const T* end, T* result, std::true_type)
+    {
+        if (first != end)
+        {
+            std::memcpy(static_cast<void*>(result), first, (end - first) * sizeof(T));
+        }
+    }
+
+    static void copyData(const T* first, const T* end, T* result, std::false_type)
+    {
+        auto* it = result;
+        try
+        {
+            for (; first != end; ++first, ++it)
+            {
+                new (it) T(*first);
+            }
+        }
+        catch (...)
+        {
+            StorageDetails::destroy(result, it);
+            throw;
+        }
+    }
+
+private:
+    Header* _header = nullptr;
+};
+
+// Restores shareability of a shared storage after a change, which hands out no references to elements.
+// It's kept only if the storage was shareable before, as references handed out earlier may still be used.
+template <typename StorageType, bool IsShared = std::is_copy_constructible<StorageType>::value>
+class ShareableGuard
+{
+public:
+    explicit ShareableGuard(StorageType&)
+    {
+    }
+};
+
+template <typename StorageType>
+class ShareableGuard<StorageType, true>
+{
+public:
+    explicit ShareableGuard(StorageType& storage)
+        : _storage(storage)
+        , _shareable(storage.shareable())
+    {
+    }
+
+    ShareableGuard(const ShareableGuard&) = delete;
+    ShareableGuard& operator=(const ShareableGuard&) = delete;
+
+    ~ShareableGuard()
+    {
+        if (_shareable)
+        {
+            _storage.markShareable();
+        }
+    }
+
+private:
+    StorageType& _storage;
+    const bool _shareable;
+};
+
+} // namespace VectorDetails
+
+template <typename StorageType, typename GrowthPolicy>
+class Vector final
+{
+public:
+    using value_type = typename StorageType::value_type;
+    using allocator_type = typename StorageType::allocator_type;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+    Vector()
+    {
+    }
+
+    explicit Vector(const allocator_type& allocator)
+        : _storage(allocator)
+    {
+    }
+
+    Vector(const Vector& other)
+        : Vector(other, IsShared())
+    {
+    }
+
+    Vector& operator=(const Vector& other)
+    {
+        if (this != &other)
+        {
+            assignCopy(other, IsShared());
+        }
+        return *this;
+    }
+
+    Vector(Vector&&) noexcept(std::is_nothrow_move_constructible<StorageType>::value) = default;
+    Vector& operator=(Vector&&) noexcept(std::is_nothrow_move_assignable<StorageType>::value) = default;
+
+    Vector(std::initializer_list<value_type> list, const allocator_type& allocator = allocator_type())
+        : Vector(std::begin(list), std::end(list), allocator)
+    {
+    }
+
+    template <typename Range>
+    Vector(Range range, const allocator_type& allocator = allocator_type())
+        : Vector(std::begin(range), std::end(range), allocator)
+    {
+    }
+
+    template <typename Iterator>
+    Vector(Iterator begin, const Iterator end, const allocator_type& allocator = allocator_type())
+        : _storage(allocator)
+    {
+        const ShareableGuard guard(_storage);
+        if (const auto size = std::distance(begin, end))
+        {
+            try
+            {
+                reserve(size);
+
+                for (auto it = this->begin(); begin != end; ++begin, ++it)
+                {
+                    new (it) value_type(*begin);
+                    _storage.advanceSize(1);
+                }
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+    }
+
+    value_type& operator[](size_t pos)
+    {
+        assert(pos < size());
+        return _storage.data()[pos];
+    }
+
+    const value_type& operator[](size_t pos) const
+    {
+        assert(pos < size());
+        return _storage.data()[pos];
+    }
+
+    value_type& front()
+    {
+        return (*this)[0U];
+    }
+
+    const value_type& front() const
+    {
+        return (*this)[0U];
+    }
+
+    value_type& back()
+    {
+        return (*this)[size() - 1U];
+    }
+
+    const value_type& back() const
+    {
+        return (*this)[size() - 1U];
+    }
+
+    iterator begin()
+    {
+        return _storage.data();
+    }
+
+    iterator end()
+    {
+        return begin() + size();
+    }
+
+    const_iterator begin() const
+    {
+        return _storage.data();
+    }
+
+    const_iterator end() const
+    {
+        return begin() + size();
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    pointer data()
+    {
+        return _storage.data();
+    }
+
+    const_pointer data() const
+    {
+        return _storage.data();
+    }
+
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    bool empty() const
+    {
+        return size() == 0U;
+    }
+
+    size_t size() const
+    {
+        return _storage.size();
+    }
+
+    size_t capacity() const
+    {
+        return _storage.capacity();
+    }
+
+    size_t max_size() const
+    {
+        return StorageType::maxSize();
+    }
+
+    allocator_type get_allocator() const
+    {
+        return _storage.getAllocator();
+    }
+
+    // Destroys elements keeping the buffer for reuse.
+    void clear()
+    {
+        const ShareableGuard guard(_storage);
+        if (isSharedWithCopies(IsShared()))
+        {
+            // Shared elements are left to the copies instead of being copied only to be destroyed.
+            _storage.free();
+        }
+        else if (const auto size = this->size())
+        {
+            VectorDetails::StorageDetails::destroy(begin(), end());
+            _storage.advanceSize(-static_cast<difference_type>(size));
+        }
+    }
+
+    // Destroys elements and frees the buffer.
+    void release()
+    {
+        _storage.free();
+    }
+
+    // Frees unused capacity. Storages may move elements into a smaller header or back to the inline buffer.
+    void shrink_to_fit()
+    {
+        const ShareableGuard guard(_storage);
+        const auto size = this->size();
+        if (size == 0U)
+        {
+            release();
+        }
+        else if (capacity() > size && !tryReallocate(size, CanReallocate()))
+        {
+            Vector tmp(get_allocator());
+            tmp._storage.allocate(size);
+            // Inline buffer of the same capacity gives nothing.
+            if (tmp.capacity() < capacity())
+            {
+                tmp.relocateFrom(*this, IsRelocatable());
+                swap(tmp);
+            }
+        }
+    }
+
+    void reserve(const size_t capacity)
+    {
+        const ShareableGuard guard(_storage);
+        if (capacity > max_size())
+        {
+            OverflowPolicy::onOverflow();
+        }
+
+        if (capacity > this->capacity())
+        {
+            reallocate(capacity);
+        }
+    }
+
+    // Value-initializes new elements.
+    void resize(const size_t size)
+    {
+        resizeImpl(size, [](value_type* it) { new (it) value_type(); });
+    }
+
+    void resize(const size_t size, const value_type& value)
+    {
+        if (size > capacity())
+        {
+            // "value" may refer to an element, which is moved on growth.
+            const value_type copy(value);
+            resizeImpl(size, [&copy](value_type* it) { new (it) value_type(copy); });
+        }
+        else
+        {
+            resizeImpl(size, [&value](value_type* it) { new (it) value_type(value); });
+        }
+    }
+
+    // Default-initializes new elements, so trivial types are left uninitialized, e.g. to be filled by a read.
+    void resize_default_init(const size_t size)
+    {
+        resizeImpl(size, [](value_type* it) { new (it) value_type; });
+    }
+
+    // Replaces elements with [begin, end), which must not belong to this vector.
+    template <typename ForwardIt>
+    void assign(ForwardIt begin, const ForwardIt& end)
+    {
+        const ShareableGuard guard(_storage);
+        const auto size = static_cast<size_t>(std::distance(begin, end));
+        if (size > capacity())
+        {
+            Vector tmp(begin, end, get_allocator());
+            *this = std::move(tmp);
+        }
+        else
+        {
+            clear();
+            append(begin, end);
+        }
+    }
+
+    template <typename ForwardIt>
+    void append(ForwardIt begin, const ForwardIt& end)
+    {
+        const ShareableGuard guard(_storage);
+        insert(this->end(), begin, end);
+    }
+
+    void push_back(const value_type& value)
+    {
+        const ShareableGuard guard(_storage);
+        emplace_back(value);
+    }
+
+    void push_back(value_type&& value)
+    {
+        const ShareableGuard guard(_storage);
+        emplace_back(std::move(value));
+    }
+
+    template <class... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if (capacity() == size())
+        {
+            return *emplaceAt(size(), IsRelocatable(), std::forward<Args>(args)...);
+        }
+
+        new (end()) value_type(std::forward<Args>(args)...);
+        _storage.advanceSize(1);
+        return back();
+    }
+
+    // Appends the element only if it fits into the capacity, i.e. without reallocation.
+    // Returns pointer to the new element or nullptr, same as std::inplace_vector.
+    template <class... Args>
+    pointer try_emplace_back(Args&&... args)
+    {
+        if (capacity() == size())
+        {
+            return nullptr;
+        }
+
+        new (end()) value_type(std::forward<Args>(args)...);
+        _storage.advanceSize(1);
+        return &back();
+    }
+
+    pointer try_push_back(const value_type& value)
+    {
+        return try_emplace_back(value);
+    }
 
-public:
-    Vector()
+    pointer try_push_back(value_type&& value)
     {
+        return try_emplace_back(std::move(value));
     }
 
-    Vector(const Vector& other)
-        : Vector(std::begin(other), std::end(other))
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
     {
+        return emplaceImpl(pos, std::forward<Args>(args)...);
     }
 
-    Vector& operator=(const Vector& other)
+    void pop_back()
     {
-        if (this != &other)
+        const ShareableGuard guard(_storage);
+        assert(size() > 0U);
+        if (size() > 0U)
         {
-            swap(Vector(other));
+            VectorDetails::StorageDetails::destroy(back());
+            _storage.advanceSize(-1);
         }
     }
 
-    Vector(Vector&&) noexcept(std::is_nothrow_move_constructible<StorageType>::value) = default;
-    Vector& operator=(Vector&&) noexcept(std::is_nothrow_move_assignable<StorageType>::value) = default;
-
-    Vector(std::initializer_list<value_type> list)
-        : Vector(std::begin(list), std::end(list))
+    iterator insert(const_iterator pos, const value_type& value)
     {
+        return emplaceImpl(pos, value);
     }
 
-    template <typename Range>
-    Vector(Range range)
-        : Vector(std::begin(range), std::end(range))
+    iterator insert(const_iterator pos, value_type&& value)
     {
+        return emplaceImpl(pos, std::move(value));
     }
 
-    template <typename Iterator>
-    Vector(Iterator begin, const Iterator end)
+    template <typename ForwardIt>
+    iterator insert(const_iterator it, ForwardIt begin, const ForwardIt& end)
     {
-        if (const auto size = std::distance(begin, end))
+        const auto dist = std::distance(cbegin(), it);
+        if (begin == end)
         {
-            try
-            {
-                reallocate(size);
+            return this->begin() + dist;
+        }
 
-                for (auto it = this->begin(); begin != end; ++begin, ++it)
-                {
-                    new (it) value_type(*begin);
-                    _storage.advanceSize(1);
-                }
-            }
-            catch (...)
-            {
-                clear();
-                throw;
-            }
+        const auto srcDist = std::distance(begin, end);
+        if (static_cast<size_t>(srcDist) > capacity() - size())
+        {
+            reserve(getNextCapacity(srcDist));
         }
-    }
+        // Restore "pos" after reallocation.
+        auto pos = this->begin() + dist;
 
-    value_type& operator[](size_t pos)
-    {
-        assert(pos < size());
-        return _storage.data()[pos];
+        insertRange(pos, begin, end, srcDist, IsRelocatable());
+        return pos;
     }
 
-    const value_type& operator[](size_t pos) const
+    iterator erase(const_iterator it)
     {
-        assert(pos < size());
-        return _storage.data()[pos];
+        return erase(it, it + 1U);
     }
 
-    value_type& front()
+    iterator erase(const const_iterator it, const const_iterator endIt)
     {
-        return (*this)[0U];
-    }
+        const auto dist = std::distance(cbegin(), it);
+        const auto result = this->begin() + dist;
+        if (it != endIt)
+        {
+            eraseRange(result, result + std::distance(it, endIt), IsRelocatable());
+        }
 
-    const value_type& front() const
-    {
-        return (*this)[0U];
+        return result;
     }
 
-    value_type& back()
+    // Removes elements matching "predicate" in one pass and returns their count.
+    template <typename Predicate>
+    size_t erase_if(Predicate predicate)
     {
-        return (*this)[size() - 1U];
+        const ShareableGuard guard(_storage);
+        return eraseIf(predicate, IsRelocatable());
     }
 
-    const value_type& back() const
+    // Erases element in O(1) by moving the last element into its place, so the order isn't preserved.
+    // Returns iterator to the element which took the erased place.
+    iterator swap_remove(const_iterator it)
     {
-        return (*this)[size() - 1U];
+        const auto pos = begin() + std::distance(cbegin(), it);
+        swapRemove(pos, IsRelocatable());
+        return pos;
     }
 
-    iterator begin()
+    // Inserts each value before the element at the corresponding index, shifting every element at most once.
+    // Indices refer to positions before insertion and must be sorted, equal indices keep the order of values.
+    // Both iterators must be bidirectional, as relocatable elements are filled from the back.
+    template <typename IndexIt, typename ValueIt>
+    void insert_batch(IndexIt indicesFirst, const IndexIt& indicesLast, ValueIt values)
     {
-        return _storage.data();
+        static_assert(std::is_base_of<std::bidirectional_iterator_tag,
+                                      typename std::iterator_traits<IndexIt>::iterator_category>::value,
+                      "Indices must be given by a bidirectional iterator");
+        static_assert(std::is_base_of<std::bidirectional_iterator_tag,
+                                      typename std::iterator_traits<ValueIt>::iterator_category>::value,
+                      "Values must be given by a bidirectional iterator");
+
+        const ShareableGuard guard(_storage);
+        const auto count = std::distance(indicesFirst, indicesLast);
+        if (count > 0)
+        {
+            assert(std::is_sorted(indicesFirst, indicesLast) && size_t(*std::prev(indicesLast)) <= size());
+            insertBatch(indicesFirst, indicesLast, values, count, IsRelocatable());
+        }
     }
 
-    iterator end()
+    bool operator==(const Vector& other) const
     {
-        return begin() + size();
+        return SCONE::equal(*this, other);
     }
 
-    const_iterator begin() const
+    bool operator!=(const Vector& other) const
     {
-        return _storage.data();
+        return !(*this == other);
     }
 
-    const_iterator end() const
+    void swap(Vector& other)
     {
-        return begin() + size();
+        _storage.swap(other._storage);
     }
 
-    reverse_iterator rbegin()
+    // Shared storages only: whether elements are not shared with copies of the vector.
+    bool unique() const
     {
-        return reverse_iterator(end());
+        return _storage.unique();
     }
 
-    reverse_iterator rend()
+    // Shared storages only: copies shared elements now, e.g. before a hot loop, so that mutations in the loop
+    // don't copy them and don't invalidate its iterators.
+    void make_unique_storage()
     {
-        return reverse_iterator(begin());
+        _storage.makeUnique();
     }
 
-    const_reverse_iterator rbegin() const
+private:
+    using IsRelocatable = IsTriviallyRelocatable<value_type>;
+    using OverflowPolicy = typename VectorDetails::StorageOverflowPolicy<StorageType>::type;
+    // Only shared storages are copyable, their copies refer to the same elements.
+    using IsShared = std::is_copy_constructible<StorageType>;
+    // Keeps shared storages shareable across changes, which hand out no references to elements.
+    using ShareableGuard = VectorDetails::ShareableGuard<StorageType>;
+    // Storages may reallocate relocatable elements, shared storages also copy shared elements of any type straight
+    // into a block of the requested capacity.
+    using CanReallocate = std::integral_constant<bool, IsRelocatable::value || IsShared::value>;
+
+    Vector(const Vector& other, std::true_type)
+        : _storage(other._storage)
     {
-        return const_reverse_iterator(end());
     }
 
-    const_reverse_iterator rend() const
+    Vector(const Vector& other, std::false_type)
+        : Vector(std::begin(other),
+                 std::end(other),
+                 std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
     {
-        return const_reverse_iterator(begin());
     }
 
-    bool empty() const
+    void assignCopy(const Vector& other, std::true_type)
     {
-        return size() == 0U;
+        Vector tmp(other);
+        swap(tmp);
     }
 
-    size_t size() const
+    void assignCopy(const Vector& other, std::false_type)
     {
-        return _storage.size();
+        Vector tmp(std::begin(other), std::end(other), get_allocator());
+        swap(tmp);
     }
 
-    size_t capacity() const
+    bool isSharedWithCopies(std::true_type) const
     {
-        return _storage.capacity();
+        return !_storage.unique();
     }
 
-    void clear()
+    bool isSharedWithCopies(std::false_type) const
     {
-        _storage.free();
+        return false;
     }
 
-    void reserve(const size_t capacity)
+    // Capacity chosen by the growth policy for "count" more elements, limited by max_size().
+    size_t getNextCapacity(const size_t count) const
     {
-        if (capacity > this->capacity())
+        if (count > max_size() - size())
         {
-            reallocate(capacity);
+            OverflowPolicy::onOverflow();
         }
+
+        const auto size = this->size() + count;
+        return std::max(size, std::min(GrowthPolicy::getNextCapacity(capacity(), size), max_size()));
     }
 
-    void push_back(const value_type& value)
+    template <typename Construct>
+    void resizeImpl(const size_t size, Construct construct)
     {
-        insertImpl(end(), value);
+        const ShareableGuard guard(_storage);
+        const auto oldSize = this->size();
+        if (size == oldSize)
+        {
+            return;
+        }
+
+        if (size < oldSize)
+        {
+            VectorDetails::StorageDetails::destroy(begin() + size, end());
+            _storage.advanceSize(static_cast<difference_type>(size) - static_cast<difference_type>(oldSize));
+            return;
+        }
+
+        if (size > capacity())
+        {
+            reserve(getNextCapacity(size - oldSize));
+        }
+
+        // Size is advanced once, after all elements are constructed.
+        const auto first = end();
+        const auto last = begin() + size;
+        auto it = first;
+        try
+        {
+            for (; it != last; ++it)
+            {
+                construct(it);
+            }
+        }
+        catch (...)
+        {
+            VectorDetails::StorageDetails::destroy(first, it);
+            throw;
+        }
+        _storage.advanceSize(static_cast<difference_type>(size - oldSize));
     }
 
-    void push_back(value_type&& value)
+    template <typename... Args>
+    iterator emplaceImpl(const_iterator it, Args&&... args)
     {
-        insertImpl(end(), std::move(value));
+        const auto dist = std::distance(cbegin(), it);
+        if (static_cast<size_t>(dist) == size())
+        {
+            emplace_back(std::forward<Args>(args)...);
+            return end() - 1;
+        }
+
+        return emplaceAt(dist, IsRelocatable(), std::forward<Args>(args)...);
     }
 
-    template <class... Args>
-    void emplace_back(Args&&... args)
+    // Element is built aside and relocated bytewise to its place, so "args" may refer to elements of this vector.
+    template <typename... Args>
+    iterator emplaceAt(const difference_type dist, std::true_type, Args&&... args)
     {
-        push_back(T(std::forward<Args>(args)...));
+        std::aligned_storage_t<sizeof(value_type), alignof(value_type)> buffer;
+        auto* const value = new (&buffer) value_type(std::forward<Args>(args)...);
+        if (capacity() == size())
+        {
+            try
+            {
+                reserve(getNextCapacity(1U));
+            }
+            catch (...)
+            {
+                VectorDetails::StorageDetails::destroy(*value);
+                throw;
+            }
+        }
+
+        const auto pos = begin() + dist;
+        VectorDetails::StorageDetails::relocate(pos, end(), pos + 1);
+        VectorDetails::StorageDetails::relocate(value, value + 1, pos);
+        _storage.advanceSize(1);
+        return pos;
     }
 
-    void pop_back()
+    template <typename... Args>
+    iterator emplaceAt(const difference_type dist, std::false_type, Args&&... args)
     {
-        assert(size() > 0U);
-        if (size() > 0U)
+        if (capacity() == size())
         {
-            _storage.advanceSize(-1);
-            VectorDetails::StorageDetails::destroy(*end());
+            return emplaceWithGrowth(dist, std::forward<Args>(args)...);
         }
+
+        // As in std::vector, the value is built before elements are shifted, so "args" may refer to them.
+        value_type value(std::forward<Args>(args)...);
+        const auto pos = begin() + dist;
+        insertAt(pos, std::move(value));
+        return pos;
     }
 
-    iterator insert(const_iterator pos, const value_type& value)
+    // Element is constructed in the new buffer before elements are moved there, so "args" may refer to them.
+    template <typename... Args>
+    iterator emplaceWithGrowth(const difference_type dist, Args&&... args)
     {
-        return insertImpl(pos, value);
+        Vector tmp(get_allocator());
+        tmp._storage.allocate(getNextCapacity(1U));
+        const auto pos = tmp.begin() + dist;
+        new (pos) value_type(std::forward<Args>(args)...);
+        try
+        {
+            tmp.moveData(begin(), begin() + dist, tmp.begin());
+        }
+        catch (...)
+        {
+            VectorDetails::StorageDetails::destroy(*pos);
+            throw;
+        }
+
+        tmp._storage.advanceSize(1);
+        tmp.moveData(begin() + dist, end(), pos + 1);
+        _storage = std::move(tmp._storage);
+        return begin() + dist;
     }
 
-    iterator insert(const_iterator pos, value_type&& value)
+    void insertAt(const iterator pos, value_type&& value)
     {
-        return insertImpl(pos, std::move(value));
+        auto it = end();
+        new (it) value_type(std::move(*(--it)));
+        _storage.advanceSize(1);
+
+        while (it != pos)
+        {
+            auto& item = *(it--);
+            item = std::move(*it);
+        }
+        *pos = std::move(value);
     }
 
     template <typename ForwardIt>
-    iterator insert(const_iterator it, ForwardIt begin, const ForwardIt& end)
+    void insertRange(iterator pos, ForwardIt begin, const ForwardIt& end, const difference_type srcDist, std::true_type)
     {
-        const auto dist = std::distance<const_iterator>(this->begin(), it);
-        if (begin == end)
+        const auto thisEnd = this->end();
+        VectorDetails::StorageDetails::relocate(pos, thisEnd, pos + srcDist);
+
+        auto it = pos;
+        try
         {
-            return this->begin() + dist;
+            for (; begin != end; ++begin, ++it)
+            {
+                new (it) value_type(*begin);
+            }
+        }
+        catch (...)
+        {
+            VectorDetails::StorageDetails::destroy(pos, it);
+            VectorDetails::StorageDetails::relocate(pos + srcDist, thisEnd + srcDist, pos);
+            throw;
         }
+        _storage.advanceSize(srcDist);
+    }
 
+    template <typename ForwardIt>
+    void insertRange(iterator pos, ForwardIt begin, const ForwardIt& end, const difference_type srcDist, std::false_type)
+    {
         const auto size = this->size();
-        const auto srcDist = std::distance(begin, end);
-        reserve(getNextCapacity(size + srcDist));
-        // Restore "pos" after reallocation.
-        auto pos = this->begin() + dist;
-
         const auto thisEnd = this->end();
         auto moveResultIt = thisEnd + srcDist;
 
@@ -560,98 +2300,199 @@ public:
             VectorDetails::StorageDetails::destroy(std::max(this->end(), moveResultIt), thisEnd + srcDist);
             throw;
         }
-
-        return pos - srcDist;
     }
 
-    iterator erase(const_iterator it)
+    void eraseRange(iterator first, iterator end, std::true_type)
     {
-        return erase(it, it + 1U);
+        const auto endDataIt = this->end();
+        VectorDetails::StorageDetails::destroy(first, end);
+        VectorDetails::StorageDetails::relocate(end, endDataIt, first);
+        _storage.advanceSize(first - end);
     }
 
-    iterator erase(const const_iterator it, const const_iterator endIt)
+    void eraseRange(iterator first, iterator end, std::false_type)
     {
-        const auto dist = std::distance<const_iterator>(this->begin(), it);
-        const auto result = this->begin() + dist;
-        if (it != endIt)
-        {
-            auto first = result;
-            auto end = first + std::distance(it, endIt);
+        const auto endDataIt = this->end();
+        first = moveData(end, endDataIt, first);
 
-            const auto endDataIt = this->end();
-            first = moveData(end, endDataIt, first);
+        _storage.advanceSize(std::distance(endDataIt, first));
+        VectorDetails::StorageDetails::destroy(first, endDataIt);
+    }
 
-            _storage.advanceSize(std::distance(endDataIt, first));
-            VectorDetails::StorageDetails::destroy(first, endDataIt);
+    template <typename Predicate>
+    size_t eraseIf(Predicate& predicate, std::true_type)
+    {
+        const auto endIt = end();
+        auto result = begin();
+        // Start of the current run of kept elements, which is relocated as a whole.
+        auto kept = result;
+        try
+        {
+            for (auto it = kept; it != endIt; ++it)
+            {
+                if (predicate(*it))
+                {
+                    VectorDetails::StorageDetails::relocate(kept, it, result);
+                    result += it - kept;
+                    VectorDetails::StorageDetails::destroy(*it);
+                    kept = it + 1;
+                }
+            }
+        }
+        catch (...)
+        {
+            VectorDetails::StorageDetails::relocate(kept, endIt, result);
+            _storage.advanceSize(result - kept);
+            throw;
         }
 
-        return result;
+        VectorDetails::StorageDetails::relocate(kept, endIt, result);
+        const auto count = kept - result;
+        if (count)
+        {
+            _storage.advanceSize(-count);
+        }
+        return static_cast<size_t>(count);
     }
 
-    bool operator==(const Vector& other) const
+    template <typename Predicate>
+    size_t eraseIf(Predicate& predicate, std::false_type)
     {
-        return size() == other.size() && std::equal(begin(), end(), other.begin());
+        const auto endIt = end();
+        const auto result = std::remove_if(begin(), endIt, predicate);
+        const auto count = endIt - result;
+        if (count)
+        {
+            VectorDetails::StorageDetails::destroy(result, endIt);
+            _storage.advanceSize(-count);
+        }
+        return static_cast<size_t>(count);
     }
 
-    bool operator!=(const Vector& other) const
+    void swapRemove(const iterator pos, std::true_type)
     {
-        return !(*this == other);
+        const auto last = end() - 1;
+        VectorDetails::StorageDetails::destroy(*pos);
+        if (pos != last)
+        {
+            VectorDetails::StorageDetails::relocate(last, last + 1, pos);
+        }
+        _storage.advanceSize(-1);
     }
 
-    void swap(Vector& other)
+    void swapRemove(const iterator pos, std::false_type)
     {
-        _storage.swap(other._storage);
+        const auto last = end() - 1;
+        if (pos != last)
+        {
+            *pos = std::move(*last);
+        }
+        pop_back();
     }
 
-private:
-    template <typename T>
-    iterator insertImpl(const_iterator it, T&& value)
+    // Fills the vector from the back, relocating each run of elements to its final place once.
+    template <typename IndexIt, typename ValueIt>
+    void insertBatch(const IndexIt& indicesFirst, IndexIt indicesLast, ValueIt values, const difference_type count, std::true_type)
     {
-        const auto size = this->size();
-        const auto dist = std::distance<const_iterator>(begin(), it);
-        if (capacity() == size)
+        if (static_cast<size_t>(count) > capacity() - size())
         {
-            reserve(getNextCapacity(size + 1U));
+            reserve(getNextCapacity(count));
         }
-        auto pos = begin() + dist;
 
-        const auto endIt = end();
-        if (pos == endIt)
+        const auto first = begin();
+        const auto last = end() + count;
+        auto valuesLast = std::next(values, count);
+        auto runEnd = end();
+        auto result = last;
+        try
         {
-            new (endIt) value_type(std::forward<T>(value));
-            _storage.advanceSize(1);
+            while (indicesLast != indicesFirst)
+            {
+                const auto pos = first + *(--indicesLast);
+                result -= runEnd - pos;
+                VectorDetails::StorageDetails::relocate(pos, runEnd, result);
+                runEnd = pos;
+
+                new (--result) value_type(*(--valuesLast));
+            }
         }
-        else
+        catch (...)
         {
-            auto it = endIt;
-            new (endIt) value_type(std::move(*(--it)));
-            _storage.advanceSize(1);
+            // Filled tail is moved to close the gap, so the vector keeps values inserted so far.
+            VectorDetails::StorageDetails::relocate(result + 1, last, runEnd);
+            _storage.advanceSize(last - result - 1 - (end() - runEnd));
+            throw;
+        }
+        _storage.advanceSize(count);
+    }
+
+    // Merges elements and values into a new buffer, as elements can't be moved bytewise.
+    template <typename IndexIt, typename ValueIt>
+    void insertBatch(IndexIt indicesFirst, const IndexIt& indicesLast, ValueIt values, const difference_type count, std::false_type)
+    {
+        Vector tmp(get_allocator());
+        tmp.reserve(static_cast<size_t>(count) > capacity() - size() ? getNextCapacity(count) : capacity());
 
-            // TODO: Optimize for POD types.
-            while (it != pos)
+        auto it = begin();
+        for (; indicesFirst != indicesLast; ++indicesFirst, ++values)
+        {
+            for (const auto pos = begin() + *indicesFirst; it != pos; ++it)
             {
-                auto& item = *(it--);
-                item = std::move(*it);
+                tmp.emplace_back(std::move(*it));
             }
-            *pos = std::forward<T>(value);
+            tmp.emplace_back(*values);
         }
 
-        return pos;
+        for (const auto endIt = end(); it != endIt; ++it)
+        {
+            tmp.emplace_back(std::move(*it));
+        }
+        *this = std::move(tmp);
     }
 
     void reallocate(const size_t capacity)
     {
         assert(capacity >= size());
+        if (tryReallocate(capacity, CanReallocate()))
+        {
+            return;
+        }
+
         Vector tmp(std::move(*this));
 
         _storage.allocate(capacity);
-        moveData(tmp.begin(), tmp.end(), begin());
+        relocateFrom(tmp, IsRelocatable());
+    }
+
+    bool tryReallocate(const size_t capacity, std::true_type)
+    {
+        return _storage.reallocate(capacity);
+    }
+
+    bool tryReallocate(const size_t, std::false_type)
+    {
+        return false;
+    }
+
+    void relocateFrom(Vector& other, std::true_type)
+    {
+        if (const auto size = other.size())
+        {
+            VectorDetails::StorageDetails::relocate(other.begin(), other.end(), begin());
+            _storage.advanceSize(size);
+            // Elements now belong to this vector, so "other" must release its buffer without destroying them.
+            other._storage.advanceSize(-static_cast<difference_type>(size));
+        }
+    }
+
+    void relocateFrom(Vector& other, std::false_type)
+    {
+        moveData(other.begin(), other.end(), begin());
     }
 
     value_type* moveData(value_type* first, value_type* end, value_type* result)
     {
         assert(first != result);
-        // TODO: Optimize for POD types.
         const auto endDataIt = this->end();
         for (; first != end; ++first, ++result)
         {
@@ -668,16 +2509,6 @@ private:
         return result;
     }
 
-    size_t getNextCapacity(const size_t size) const
-    {
-        size_t result = 0U;
-        if (size > 0U)
-        {
-            result = (1U << (getHighestBit(size) + 1)) - 1;
-        }
-        return result;
-    }
-
 private:
     StorageType _storage;
 };
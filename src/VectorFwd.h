@@ -1,26 +1,109 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 
 namespace SCONE
 {
+template <typename T>
+class PolymorphicAllocator;
+
+template <typename T, size_t Alignment>
+class AlignedAllocator;
+
+struct PowerOfTwoGrowth;
+struct ThrowOnOverflow;
+
 namespace VectorDetails
 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>, size_t Alignment = alignof(T)>
 class MemoryOptimizedStorage;
 
-template <typename T, uint32_t InlineSize>
+template <typename T, uint32_t InlineSize, typename Allocator = std::allocator<T>, size_t Alignment = alignof(T)>
 class InlineStorage;
 
+template <typename T, size_t Size, typename Allocator = std::allocator<T>>
+class PackedInlineStorage;
+
+template <typename T, uint32_t Capacity, typename OverflowPolicy = ThrowOnOverflow>
+class StaticStorage;
+
+template <typename T, typename Allocator = std::allocator<T>>
+class TaggedSizeStorage;
+
+template <typename T, typename Allocator = std::allocator<T>>
+class SharedStorage;
+
 } // namespace VectorDetails
 
-template <typename StorageType>
+template <typename StorageType, typename GrowthPolicy = PowerOfTwoGrowth>
 class Vector;
 
-template <typename T>
-using CompactVector = Vector<VectorDetails::MemoryOptimizedStorage<T>>;
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = PowerOfTwoGrowth>
+using CompactVector = Vector<VectorDetails::MemoryOptimizedStorage<T, Allocator>, GrowthPolicy>;
+
+template <typename T,
+          uint32_t InlineSize = 1U,
+          typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = PowerOfTwoGrowth>
+using InlineVector = Vector<VectorDetails::InlineStorage<T, InlineSize, Allocator>, GrowthPolicy>;
+
+// InlineVector which takes exactly "Size" bytes (with a stateless allocator) and keeps as many elements inline
+// as fit into them, e.g. 31 uint8_t or 7 uint32_t elements in 32 bytes.
+template <typename T,
+          size_t Size = 32U,
+          typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = PowerOfTwoGrowth>
+using PackedInlineVector = Vector<VectorDetails::PackedInlineStorage<T, Size, Allocator>, GrowthPolicy>;
+
+// Vector of at most "Capacity" elements without heap allocations, e.g. for bounded collections on hot paths.
+// OverflowPolicy is ThrowOnOverflow or AssertOnOverflow, try_push_back() reports overflow without either.
+template <typename T, uint32_t Capacity, typename OverflowPolicy = ThrowOnOverflow>
+using StaticVector = Vector<VectorDetails::StaticStorage<T, Capacity, OverflowPolicy>>;
+
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = PowerOfTwoGrowth>
+using TaggedVector = Vector<VectorDetails::TaggedSizeStorage<T, Allocator>, GrowthPolicy>;
+
+// CompactVector with copy-on-write elements: copies are O(1) and share elements until one of them is changed,
+// e.g. for read-mostly snapshots. Non-const access to shared elements copies them, see make_unique_storage().
+// Once non-const access handed out references or iterators, copies of the vector copy elements, so that writes
+// through them aren't seen by the copies. Changes returning no references, e.g. push_back(), keep it shareable.
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = PowerOfTwoGrowth>
+using SharedCompactVector = Vector<VectorDetails::SharedStorage<T, Allocator>, GrowthPolicy>;
+
+// Element arrays start at "Alignment" boundary, e.g. for aligned SIMD loads. Inline elements of InlineVector keep
+// their natural alignment. Allocator must honour alignment of over-aligned types, as AlignedAllocator does.
+template <typename T,
+          size_t Alignment,
+          typename Allocator = AlignedAllocator<T, Alignment>,
+          typename GrowthPolicy = PowerOfTwoGrowth>
+using AlignedCompactVector = Vector<VectorDetails::MemoryOptimizedStorage<T, Allocator, Alignment>, GrowthPolicy>;
+
+template <typename T,
+          uint32_t InlineSize,
+          size_t Alignment,
+          typename Allocator = AlignedAllocator<T, Alignment>,
+          typename GrowthPolicy = PowerOfTwoGrowth>
+using AlignedInlineVector = Vector<VectorDetails::InlineStorage<T, InlineSize, Allocator, Alignment>, GrowthPolicy>;
+
+namespace pmr
+{
+template <typename T, typename GrowthPolicy = PowerOfTwoGrowth>
+using CompactVector = SCONE::CompactVector<T, PolymorphicAllocator<T>, GrowthPolicy>;
+
+template <typename T, uint32_t InlineSize = 1U, typename GrowthPolicy = PowerOfTwoGrowth>
+using InlineVector = SCONE::InlineVector<T, InlineSize, PolymorphicAllocator<T>, GrowthPolicy>;
+
+template <typename T, size_t Size = 32U, typename GrowthPolicy = PowerOfTwoGrowth>
+using PackedInlineVector = SCONE::PackedInlineVector<T, Size, PolymorphicAllocator<T>, GrowthPolicy>;
+
+template <typename T, typename GrowthPolicy = PowerOfTwoGrowth>
+using TaggedVector = SCONE::TaggedVector<T, PolymorphicAllocator<T>, GrowthPolicy>;
+
+template <typename T, typename GrowthPolicy = PowerOfTwoGrowth>
+using SharedCompactVector = SCONE::SharedCompactVector<T, PolymorphicAllocator<T>, GrowthPolicy>;
 
-template <typename T, uint32_t InlineSize = 1U>
-using InlineVector = Vector<VectorDetails::InlineStorage<T, InlineSize>>;
+} // namespace pmr
 
 } // namespace SCONE
@@ -0,0 +1,218 @@
+#include "src/Algorithms.h"
+#include "src/Vector.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+namespace
+{
+using InstructionSet = AlgorithmsDetails::InstructionSet;
+
+// Runs "test" with each instruction set supported by the CPU and restores the detected one.
+template <typename Test>
+void forEachInstructionSet(Test test)
+{
+    const auto detected = AlgorithmsDetails::getInstructionSet();
+    for (const auto instructionSet : {InstructionSet::Scalar, InstructionSet::Sse2, InstructionSet::Avx2})
+    {
+        if (AlgorithmsDetails::setInstructionSet(instructionSet))
+        {
+            SCOPED_TRACE(static_cast<int>(instructionSet));
+            test();
+        }
+    }
+    AlgorithmsDetails::setInstructionSet(detected);
+}
+
+// Few distinct values, so that searches hit, and the extremes of the type.
+template <typename T>
+CompactVector<T> makeRandomVector(const size_t size, std::mt19937& random)
+{
+    const T values[] = {T(0), T(1), T(2), T(3), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()};
+    std::uniform_int_distribution<size_t> index(0U, sizeof(values) / sizeof(values[0U]) - 1U);
+
+    CompactVector<T> result;
+    for (size_t i = 0U; i < size; ++i)
+    {
+        result.push_back(values[index(random)]);
+    }
+    return result;
+}
+
+// Integers wrap around.
+template <typename T>
+T getExpectedSum(const CompactVector<T>& vector, std::true_type /*integral*/)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    Unsigned result = 0U;
+    for (const auto item : vector)
+    {
+        result = static_cast<Unsigned>(result + static_cast<Unsigned>(item));
+    }
+    return static_cast<T>(result);
+}
+
+template <typename T>
+T getExpectedSum(const CompactVector<T>& vector, std::false_type /*integral*/)
+{
+    return std::accumulate(vector.begin(), vector.end(), T());
+}
+} // namespace
+
+template <typename T>
+class AlgorithmsTestSuite : public ::testing::Test
+{
+};
+
+using AlgorithmsTypes = ::testing::
+    Types<char, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t, long long, float, double>;
+TYPED_TEST_SUITE(AlgorithmsTestSuite, AlgorithmsTypes);
+
+TYPED_TEST(AlgorithmsTestSuite, testSearch)
+{
+    std::mt19937 random(42U);
+    forEachInstructionSet([&random]() {
+        for (size_t size = 0U; size < 100U; ++size)
+        {
+            const auto vector = makeRandomVector<TypeParam>(size, random);
+            for (const auto value : {TypeParam(1), TypeParam(3), std::numeric_limits<TypeParam>::max(), TypeParam(7)})
+            {
+                EXPECT_EQ(std::find(vector.begin(), vector.end(), value), find(vector, value));
+                EXPECT_EQ(std::count(vector.begin(), vector.end(), value), ptrdiff_t(count(vector, value)));
+                EXPECT_EQ(std::find(vector.begin(), vector.end(), value) != vector.end(), contains(vector, value));
+            }
+        }
+    });
+}
+
+// Byte-wide counters of the kernels would overflow without summing them up regularly.
+TYPED_TEST(AlgorithmsTestSuite, testCountMany)
+{
+    forEachInstructionSet([]() {
+        CompactVector<TypeParam> vector;
+        vector.resize(10000U, TypeParam(1));
+        vector[5000U] = TypeParam(2);
+        EXPECT_EQ(9999U, count(vector, TypeParam(1)));
+        EXPECT_EQ(vector.begin() + 5000, find(vector, TypeParam(2)));
+    });
+}
+
+TYPED_TEST(AlgorithmsTestSuite, testEqual)
+{
+    std::mt19937 random(42U);
+    forEachInstructionSet([&random]() {
+        for (size_t size = 0U; size < 100U; ++size)
+        {
+            const auto vector = makeRandomVector<TypeParam>(size, random);
+            auto other = vector;
+            EXPECT_TRUE(equal(vector, other));
+            EXPECT_TRUE(vector == other);
+
+            for (size_t i = 0U; i < size; ++i)
+            {
+                other[i] = TypeParam(other[i] == TypeParam(1) ? 2 : 1);
+                EXPECT_FALSE(equal(vector, other));
+                other[i] = vector[i];
+            }
+
+            other.push_back(TypeParam(1));
+            EXPECT_FALSE(vector == other);
+        }
+    });
+}
+
+TYPED_TEST(AlgorithmsTestSuite, testReduce)
+{
+    std::mt19937 random(42U);
+    forEachInstructionSet([&random]() {
+        for (size_t size = 0U; size < 100U; ++size)
+        {
+            auto vector = makeRandomVector<TypeParam>(size, random);
+            EXPECT_EQ(std::min_element(vector.begin(), vector.end()), minElement(vector));
+            EXPECT_EQ(std::max_element(vector.begin(), vector.end()), maxElement(vector));
+
+            // Values which are exactly representable keep the floating point sum independent of the order.
+            std::replace(vector.begin(), vector.end(), std::numeric_limits<TypeParam>::lowest(), TypeParam(5));
+            std::replace(vector.begin(), vector.end(), std::numeric_limits<TypeParam>::max(), TypeParam(7));
+            if (std::is_integral<TypeParam>::value)
+            {
+                vector.push_back(std::numeric_limits<TypeParam>::max());
+            }
+            EXPECT_EQ(getExpectedSum(vector, std::is_integral<TypeParam>()), sum(vector));
+        }
+    });
+}
+
+template <typename T>
+class AlgorithmsFloatingTestSuite : public ::testing::Test
+{
+};
+
+using AlgorithmsFloatingTypes = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(AlgorithmsFloatingTestSuite, AlgorithmsFloatingTypes);
+
+TYPED_TEST(AlgorithmsFloatingTestSuite, testSpecialValues)
+{
+    forEachInstructionSet([]() {
+        const auto nan = std::numeric_limits<TypeParam>::quiet_NaN();
+        CompactVector<TypeParam> vector;
+        for (size_t i = 0U; i < 40U; ++i)
+        {
+            vector.push_back(TypeParam(i));
+        }
+        vector[20U] = nan;
+        vector[30U] = TypeParam(-0.0);
+
+        // Comparisons follow operator==: NaN matches nothing, zeros of both signs match each other.
+        EXPECT_FALSE(contains(vector, nan));
+        EXPECT_EQ(0U, count(vector, nan));
+        EXPECT_EQ(vector.begin(), find(vector, TypeParam(-0.0)));
+        EXPECT_EQ(2U, count(vector, TypeParam(0.0)));
+        EXPECT_FALSE(vector == vector);
+
+        auto other = vector;
+        other[20U] = TypeParam(20);
+        other[30U] = TypeParam(0.0);
+        vector[20U] = TypeParam(20);
+        EXPECT_TRUE(vector == other);
+        EXPECT_TRUE(std::signbit(vector[30U]) && !std::signbit(other[30U]));
+    });
+}
+
+TEST(AlgorithmsTestSuite, testOtherContainers)
+{
+    std::vector<int32_t> vector(50U, 1);
+    vector[33U] = 2;
+    const InlineVector<int32_t, 4U> inlineVector(vector.begin(), vector.begin() + 3);
+
+    EXPECT_EQ(vector.begin() + 33, find(vector, 2));
+    *find(vector, 2) = 3;
+    EXPECT_EQ(49U, count(vector, 1));
+    EXPECT_EQ(vector.begin() + 33, maxElement(vector));
+    EXPECT_EQ(52, sum(vector));
+    EXPECT_TRUE(equal(inlineVector, std::vector<int32_t>(3U, 1)));
+    EXPECT_EQ(inlineVector.end(), find(inlineVector, 3));
+
+    // Types without kernels use the std algorithms.
+    const TaggedVector<std::string> strings;
+    EXPECT_FALSE(contains(strings, "value"));
+    EXPECT_EQ(strings.end(), minElement(strings));
+    const std::vector<std::string> words = {"b", "a", "c", "a"};
+    EXPECT_EQ(2U, count(words, "a"));
+    EXPECT_EQ(words.begin() + 1, minElement(words));
+    EXPECT_EQ("baca", sum(words));
+}
+
+} // namespace UT
+} // namespace SCONE
@@ -0,0 +1,153 @@
+#include "src/ConcurrentVector.h"
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+using namespace testing;
+
+TEST(ConcurrentVectorTestSuite, testPushBack)
+{
+    ConcurrentVector<size_t> testArray;
+    EXPECT_TRUE(testArray.empty());
+    std::vector<const size_t*> addresses;
+    for (size_t i = 0U; i < 100000U; ++i)
+    {
+        ASSERT_EQ(i, testArray.push_back(i));
+        addresses.push_back(&testArray[i]);
+    }
+
+    ASSERT_EQ(100000U, testArray.size());
+    for (size_t i = 0U; i < testArray.size(); ++i)
+    {
+        ASSERT_EQ(i, testArray[i]);
+        ASSERT_EQ(addresses[i], &testArray[i]);
+    }
+    EXPECT_EQ(size_t(99999U) * 100000U / 2U, std::accumulate(testArray.cbegin(), testArray.cend(), size_t(0U)));
+}
+
+TEST(ConcurrentVectorTestSuite, testLifetime)
+{
+    const std::string prefix = "long enough string to be allocated #";
+    ConcurrentVector<std::string> testArray;
+    testArray.reserve(1000U);
+    for (int i = 0; i < 1000; ++i)
+    {
+        testArray.emplace_back(prefix + std::to_string(i));
+    }
+
+    const auto& constArray = testArray;
+    EXPECT_EQ(prefix + "999", constArray[999U]);
+    EXPECT_EQ(1000, std::count_if(testArray.begin(), testArray.end(), [&prefix](const std::string& value) {
+                  return value.compare(0U, prefix.size(), prefix) == 0;
+              }));
+}
+
+TEST(ConcurrentVectorTestSuite, testConcurrentPushBack)
+{
+    constexpr size_t ThreadCount = 8U;
+    constexpr size_t Count = 100000U;
+    ConcurrentVector<uint64_t> testArray;
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 0U; thread < ThreadCount; ++thread)
+    {
+        threads.emplace_back([&testArray, thread] {
+            for (uint64_t i = 0U; i < Count; ++i)
+            {
+                testArray.push_back(thread * Count + i);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every value is kept once.
+    ASSERT_EQ(ThreadCount * Count, testArray.size());
+    std::vector<uint64_t> values(testArray.begin(), testArray.end());
+    std::sort(values.begin(), values.end());
+    for (uint64_t i = 0U; i < values.size(); ++i)
+    {
+        ASSERT_EQ(i, values[i]);
+    }
+}
+
+// Readers get indices of pushed elements from writers and read them while writers keep pushing.
+TEST(ConcurrentVectorTestSuite, testConcurrentReads)
+{
+    constexpr size_t WriterCount = 4U;
+    constexpr size_t Count = 20000U;
+    ConcurrentVector<std::string> testArray;
+    std::atomic<size_t> lastIndices[WriterCount];
+    for (auto& index : lastIndices)
+    {
+        index.store(std::numeric_limits<size_t>::max());
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t writer = 0U; writer < WriterCount; ++writer)
+    {
+        threads.emplace_back([&, writer] {
+            for (size_t i = 0U; i < Count; ++i)
+            {
+                const auto index = testArray.push_back(std::to_string(writer) + ":" + std::to_string(i) +
+                                                       " long enough string to be allocated");
+                lastIndices[writer].store(index, std::memory_order_release);
+            }
+        });
+    }
+
+    std::atomic<size_t> checked{0U};
+    for (size_t reader = 0U; reader < WriterCount; ++reader)
+    {
+        threads.emplace_back([&, reader] {
+            size_t previous = 0U;
+            for (size_t i = 0U; i < Count; ++i)
+            {
+                const auto index = lastIndices[reader].load(std::memory_order_acquire);
+                if (index != std::numeric_limits<size_t>::max())
+                {
+                    const auto& value = testArray[index];
+                    const auto number = std::stoul(value.substr(value.find(':') + 1U));
+                    EXPECT_EQ(std::to_string(reader) + ":", value.substr(0U, value.find(':') + 1U));
+                    EXPECT_LE(previous, number);
+                    previous = number;
+                    checked.fetch_add(1U);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(WriterCount * Count, testArray.size());
+    EXPECT_LT(0U, checked.load());
+}
+
+TEST(ConcurrentVectorTestSuite, testPolymorphicAllocator)
+{
+    pmr::ConcurrentVector<int> testArray{PolymorphicAllocator<int>()};
+    for (int i = 0; i < 1000; ++i)
+    {
+        testArray.push_back(i);
+    }
+    EXPECT_EQ(999, testArray[999U]);
+}
+
+} // namespace UT
+} // namespace SCONE
@@ -0,0 +1,87 @@
+#include "src/GrowthPolicy.h"
+#include "src/Vector.h"
+
+#include <gmock/gmock.h>
+
+#include <limits>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+using namespace testing;
+
+static_assert(getHighestBit(0U) == -1, "");
+static_assert(getHighestBit(1U) == 0, "");
+static_assert(getHighestBit(6U) == 2, "");
+static_assert(getHighestBit(size_t(1U) << 40U) == 40, "");
+
+static_assert(PowerOfTwoGrowth::getNextCapacity(0U, 0U) == 0U, "");
+static_assert(PowerOfTwoGrowth::getNextCapacity(3U, 4U) == 7U, "");
+static_assert(OneAndHalfGrowth::getNextCapacity(0U, 1U) == 1U, "");
+static_assert(OneAndHalfGrowth::getNextCapacity(10U, 11U) == 15U, "");
+static_assert(FixedIncrementGrowth<8U>::getNextCapacity(10U, 11U) == 18U, "");
+static_assert(FixedIncrementGrowth<8U>::getNextCapacity(10U, 30U) == 30U, "");
+static_assert(ExactGrowth::getNextCapacity(10U, 11U) == 11U, "");
+
+// Growth saturates instead of overflowing.
+constexpr auto MaxSize = std::numeric_limits<size_t>::max();
+static_assert(PowerOfTwoGrowth::getNextCapacity(0U, MaxSize / 2U + 2U) == MaxSize, "");
+static_assert(OneAndHalfGrowth::getNextCapacity(MaxSize - 2U, MaxSize - 1U) == MaxSize, "");
+static_assert(FixedIncrementGrowth<8U>::getNextCapacity(MaxSize - 4U, MaxSize - 3U) == MaxSize, "");
+
+template <typename VectorType>
+std::vector<size_t> getPushBackCapacities(const size_t count)
+{
+    std::vector<size_t> result;
+    VectorType vector;
+    for (size_t i = 0U; i < count; ++i)
+    {
+        vector.push_back(static_cast<int>(i));
+        result.push_back(vector.capacity());
+    }
+    return result;
+}
+
+TEST(GrowthPolicyTestSuite, testPushBackCapacities)
+{
+    EXPECT_THAT(getPushBackCapacities<CompactVector<int>>(8U), ElementsAre(1, 3, 3, 7, 7, 7, 7, 15));
+    EXPECT_THAT((getPushBackCapacities<CompactVector<int, std::allocator<int>, OneAndHalfGrowth>>(8U)),
+                ElementsAre(1, 2, 3, 4, 6, 6, 9, 9));
+    EXPECT_THAT((getPushBackCapacities<CompactVector<int, std::allocator<int>, FixedIncrementGrowth<3U>>>(8U)),
+                ElementsAre(3, 3, 3, 6, 6, 6, 9, 9));
+    EXPECT_THAT((getPushBackCapacities<InlineVector<int, 2U, std::allocator<int>, ExactGrowth>>(4U)),
+                ElementsAre(2, 2, 3, 4));
+}
+
+TEST(GrowthPolicyTestSuite, testInsertRange)
+{
+    const int array[] = {1, 2, 3, 4, 5};
+
+    CompactVector<int, std::allocator<int>, ExactGrowth> exactArray = {0};
+    exactArray.insert(exactArray.end(), std::begin(array), std::end(array));
+    EXPECT_EQ(6U, exactArray.capacity());
+
+    CompactVector<int> powerOfTwoArray = {0};
+    powerOfTwoArray.insert(powerOfTwoArray.end(), std::begin(array), std::end(array));
+    EXPECT_EQ(7U, powerOfTwoArray.capacity());
+}
+
+TEST(GrowthPolicyTestSuite, testMaxSize)
+{
+    CompactVector<int> compactArray;
+    EXPECT_GT(compactArray.max_size(), size_t(std::numeric_limits<uint32_t>::max()));
+    EXPECT_THROW(compactArray.reserve(compactArray.max_size() + 1U), std::length_error);
+
+    InlineVector<int> inlineArray;
+    EXPECT_EQ(std::numeric_limits<uint32_t>::max(), inlineArray.max_size());
+    EXPECT_THROW(inlineArray.reserve(size_t(std::numeric_limits<uint32_t>::max()) + 1U), std::length_error);
+
+    TaggedVector<int> taggedArray;
+    EXPECT_EQ(std::numeric_limits<uint32_t>::max(), taggedArray.max_size());
+    EXPECT_THROW(taggedArray.reserve(size_t(std::numeric_limits<uint32_t>::max()) + 1U), std::length_error);
+}
+
+} // namespace UT
+} // namespace SCONE
@@ -0,0 +1,71 @@
+#include "src/MallocAllocator.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+
+TEST(MallocAllocatorTestSuite, testReallocatePreservesData)
+{
+    MallocAllocator<int> allocator;
+
+    // Grow within malloc, from malloc to mmap, within mmap and back to malloc.
+    const std::vector<size_t> counts = {16U,
+                                        1024U,
+                                        MallocDetails::MmapThreshold / sizeof(int) + 1U,
+                                        4U * MallocDetails::MmapThreshold / sizeof(int),
+                                        16U};
+
+    auto* ptr = allocator.allocate(counts.front());
+    std::iota(ptr, ptr + counts.front(), 0);
+
+    for (size_t i = 1U; i < counts.size(); ++i)
+    {
+        const auto oldCount = counts[i - 1U];
+        const auto newCount = counts[i];
+        ptr = allocator.reallocate(ptr, oldCount, newCount).ptr;
+
+        const auto count = std::min(oldCount, newCount);
+        for (size_t j = 0U; j < count; ++j)
+        {
+            ASSERT_EQ(static_cast<int>(j), ptr[j]);
+        }
+        std::iota(ptr, ptr + newCount, 0);
+    }
+
+    allocator.deallocate(ptr, counts.back());
+}
+
+TEST(MallocAllocatorTestSuite, testAllocateAtLeast)
+{
+    MallocAllocator<char> allocator;
+    for (const size_t count : {size_t(1U), size_t(100U), MallocDetails::MmapThreshold - 1U, MallocDetails::MmapThreshold})
+    {
+        const auto allocation = allocator.allocate_at_least(count);
+        ASSERT_LE(count, allocation.count);
+        // Whole reported block is usable.
+        std::fill(allocation.ptr, allocation.ptr + allocation.count, 'a');
+        allocator.deallocate(allocation.ptr, allocation.count);
+    }
+}
+
+TEST(MallocAllocatorTestSuite, testAlignment)
+{
+    MallocAllocator<double> allocator;
+    for (const size_t count : {size_t(1U), size_t(100U), MallocDetails::MmapThreshold})
+    {
+        auto* ptr = allocator.allocate(count);
+        EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t));
+        allocator.deallocate(ptr, count);
+    }
+}
+
+} // namespace UT
+} // namespace SCONE
@@ -0,0 +1,156 @@
+#include "src/MonotonicBufferResource.h"
+#include "src/Vector.h"
+
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+using namespace testing;
+
+namespace
+{
+class UpstreamResource final : public MemoryResource
+{
+public:
+    void* allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        liveBytes += bytes;
+        return getNewDeleteResource()->allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        liveBytes -= bytes;
+        getNewDeleteResource()->deallocate(ptr, bytes, alignment);
+    }
+
+public:
+    size_t allocations = 0U;
+    size_t liveBytes = 0U;
+};
+
+bool isAligned(const void* ptr, const size_t alignment)
+{
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0U;
+}
+} // namespace
+
+TEST(MonotonicBufferResourceTestSuite, testBufferIsUsedFirst)
+{
+    UpstreamResource upstream;
+    alignas(16) char buffer[256];
+    MonotonicBufferResource resource(buffer, sizeof(buffer), &upstream);
+
+    auto* first = static_cast<char*>(resource.allocate(1U, 1U));
+    auto* second = static_cast<char*>(resource.allocate(8U, 8U));
+    auto* third = static_cast<char*>(resource.allocate(4U, 4U));
+    EXPECT_EQ(buffer, first);
+    EXPECT_EQ(buffer + 8, second);
+    EXPECT_EQ(buffer + 16, third);
+    EXPECT_EQ(0U, upstream.allocations);
+
+    // Deallocation doesn't reuse memory.
+    resource.deallocate(third, 4U, 4U);
+    EXPECT_EQ(buffer + 20, resource.allocate(4U, 4U));
+
+    // Buffer is exhausted.
+    resource.allocate(256U, 1U);
+    EXPECT_EQ(1U, upstream.allocations);
+}
+
+TEST(MonotonicBufferResourceTestSuite, testRelease)
+{
+    UpstreamResource upstream;
+    char buffer[64];
+    MonotonicBufferResource resource(buffer, sizeof(buffer), &upstream);
+
+    for (size_t i = 0U; i < 1000U; ++i)
+    {
+        ASSERT_TRUE(isAligned(resource.allocate(24U, 8U), 8U));
+    }
+    EXPECT_LT(0U, upstream.allocations);
+    EXPECT_GT(10U, upstream.allocations);
+
+    resource.release();
+    EXPECT_EQ(0U, upstream.liveBytes);
+    EXPECT_EQ(buffer, resource.allocate(1U, 1U));
+
+    // Memory taken before release is allocated as one chunk.
+    const auto allocations = upstream.allocations;
+    for (size_t i = 0U; i < 1000U; ++i)
+    {
+        resource.allocate(24U, 8U);
+    }
+    EXPECT_GE(allocations + 1U, upstream.allocations);
+
+    // Chunks don't keep growing when the arena is reused for the same amount of memory.
+    size_t chunksSize = 0U;
+    for (size_t round = 0U; round < 100U; ++round)
+    {
+        resource.release();
+        for (size_t i = 0U; i < 1000U; ++i)
+        {
+            resource.allocate(24U, 8U);
+        }
+        chunksSize = round ? chunksSize : upstream.liveBytes;
+        ASSERT_EQ(chunksSize, upstream.liveBytes);
+    }
+}
+
+TEST(MonotonicBufferResourceTestSuite, testAlignment)
+{
+    UpstreamResource upstream;
+    {
+        MonotonicBufferResource resource(&upstream);
+        for (const size_t alignment : {1U, 2U, 8U, 64U, 4096U, 2U, 16U})
+        {
+            for (const size_t bytes : {1U, 3U, 100U, 10000U})
+            {
+                ASSERT_TRUE(isAligned(resource.allocate(bytes, alignment), alignment));
+            }
+        }
+    }
+    EXPECT_EQ(0U, upstream.liveBytes);
+}
+
+TEST(MonotonicBufferResourceTestSuite, testInlineVectors)
+{
+    UpstreamResource upstream;
+    char buffer[4096];
+    MonotonicBufferResource resource(buffer, sizeof(buffer), &upstream);
+
+    for (int request = 0; request < 3; ++request)
+    {
+        std::vector<pmr::InlineVector<int, 2>> vectors;
+        for (int i = 0; i < 100; ++i)
+        {
+            vectors.emplace_back(PolymorphicAllocator<int>(&resource));
+            for (int j = 0; j < i % 10; ++j)
+            {
+                vectors.back().push_back(j);
+            }
+        }
+
+        for (int i = 0; i < 100; ++i)
+        {
+            ASSERT_EQ(static_cast<size_t>(i % 10), vectors[i].size());
+            for (int j = 0; j < i % 10; ++j)
+            {
+                ASSERT_EQ(j, vectors[i][j]);
+            }
+        }
+
+        vectors.clear();
+        resource.release();
+        EXPECT_EQ(0U, upstream.liveBytes);
+    }
+}
+
+} // namespace UT
+} // namespace SCONE
@@ -0,0 +1,186 @@
+#include "src/PoolAllocator.h"
+#include "src/Vector.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+
+TEST(PoolAllocatorTestSuite, testAllocateAtLeast)
+{
+    PoolAllocator<char> allocator;
+    size_t previous = 0U;
+    for (size_t count = 1U; count <= 2U * PoolDetails::MaxBlockSize; ++count)
+    {
+        const auto allocation = allocator.allocate_at_least(count);
+        ASSERT_LE(count, allocation.count);
+        // Blocks are rounded to size classes.
+        ASSERT_LE(previous, allocation.count);
+        ASSERT_EQ(0U, reinterpret_cast<uintptr_t>(allocation.ptr) % PoolDetails::BlockAlignment);
+        // Whole reported block is usable.
+        std::fill(allocation.ptr, allocation.ptr + allocation.count, 'a');
+        allocator.deallocate(allocation.ptr, allocation.count);
+        previous = allocation.count;
+    }
+}
+
+TEST(PoolAllocatorTestSuite, testBlocksAreReused)
+{
+    PoolAllocator<uint32_t> allocator;
+    auto* ptr = allocator.allocate(3U);
+    allocator.deallocate(ptr, 3U);
+    EXPECT_EQ(ptr, allocator.allocate(4U));
+    allocator.deallocate(ptr, 4U);
+}
+
+TEST(PoolAllocatorTestSuite, testBlocksDontOverlap)
+{
+    PoolAllocator<uint64_t> allocator;
+    std::vector<uint64_t*> blocks;
+    for (size_t i = 0U; i < 10000U; ++i)
+    {
+        blocks.push_back(allocator.allocate(1U + i % 4U));
+        std::fill(blocks.back(), blocks.back() + 1U + i % 4U, i);
+    }
+
+    for (size_t i = 0U; i < blocks.size(); ++i)
+    {
+        for (size_t j = 0U; j < 1U + i % 4U; ++j)
+        {
+            ASSERT_EQ(i, blocks[i][j]);
+        }
+    }
+
+    for (size_t i = 0U; i < blocks.size(); ++i)
+    {
+        allocator.deallocate(blocks[i], 1U + i % 4U);
+    }
+}
+
+TEST(PoolAllocatorTestSuite, testCompactVectors)
+{
+    std::vector<CompactVector<uint32_t, PoolAllocator<uint32_t>>> vectors(1000U);
+    for (size_t i = 0U; i < vectors.size(); ++i)
+    {
+        for (uint32_t j = 0U; j < i % 100U; ++j)
+        {
+            vectors[i].push_back(j);
+        }
+    }
+
+    for (size_t i = 0U; i < vectors.size(); ++i)
+    {
+        ASSERT_EQ(i % 100U, vectors[i].size());
+        for (uint32_t j = 0U; j < vectors[i].size(); ++j)
+        {
+            ASSERT_EQ(j, vectors[i][j]);
+        }
+    }
+}
+
+// Blocks allocated by one thread and deallocated by others are reused without corruption.
+TEST(PoolAllocatorTestSuite, testDeallocationByOtherThreads)
+{
+    PoolAllocator<uint64_t> allocator;
+    constexpr size_t Count = 10000U;
+    std::vector<uint64_t*> blocks;
+    for (size_t i = 0U; i < Count; ++i)
+    {
+        blocks.push_back(allocator.allocate(2U));
+        blocks.back()[0] = blocks.back()[1] = i;
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 0U; thread < 4U; ++thread)
+    {
+        threads.emplace_back([&blocks, thread] {
+            PoolAllocator<uint64_t> threadAllocator;
+            std::vector<uint64_t*> own;
+            for (size_t i = thread; i < Count; i += 4U)
+            {
+                threadAllocator.deallocate(blocks[i], 2U);
+                own.push_back(threadAllocator.allocate(2U));
+                own.back()[0] = own.back()[1] = thread;
+            }
+            for (auto* ptr : own)
+            {
+                EXPECT_EQ(thread, ptr[0]);
+                EXPECT_EQ(thread, ptr[1]);
+                threadAllocator.deallocate(ptr, 2U);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Blocks released by the exited threads are handed out again, each at most once.
+    std::set<uint64_t*> reused;
+    for (size_t i = 0U; i < Count; ++i)
+    {
+        EXPECT_TRUE(reused.insert(allocator.allocate(2U)).second);
+    }
+    for (auto* ptr : reused)
+    {
+        allocator.deallocate(ptr, 2U);
+    }
+}
+
+// Deallocates blocks when the thread exits, after the pool released the thread cache.
+struct LateDeallocator
+{
+    ~LateDeallocator()
+    {
+        PoolAllocator<uint64_t> allocator;
+        for (auto* ptr : blocks)
+        {
+            allocator.deallocate(ptr, BlockCount);
+        }
+        allocator.deallocate(allocator.allocate(BlockCount), BlockCount);
+    }
+
+    static constexpr size_t BlockCount = 24U;
+    std::vector<uint64_t*> blocks;
+};
+
+// Blocks deallocated by thread_local destructors after the cleanup reach the shared lists.
+TEST(PoolAllocatorTestSuite, testDeallocationAfterThreadExit)
+{
+    constexpr size_t Count = 100U;
+    std::set<uint64_t*> late;
+    std::thread([&late] {
+        // Constructed before the thread cache is registered, so it's destroyed after the cache is released.
+        static thread_local LateDeallocator deallocator;
+        PoolAllocator<uint64_t> threadAllocator;
+        for (size_t i = 0U; i < Count; ++i)
+        {
+            deallocator.blocks.push_back(threadAllocator.allocate(LateDeallocator::BlockCount));
+        }
+        late.insert(deallocator.blocks.begin(), deallocator.blocks.end());
+    }).join();
+
+    PoolAllocator<uint64_t> allocator;
+    std::vector<uint64_t*> blocks;
+    for (size_t i = 0U; i < 100U * Count && !late.empty(); ++i)
+    {
+        blocks.push_back(allocator.allocate(LateDeallocator::BlockCount));
+        late.erase(blocks.back());
+    }
+    EXPECT_TRUE(late.empty());
+    for (auto* ptr : blocks)
+    {
+        allocator.deallocate(ptr, LateDeallocator::BlockCount);
+    }
+}
+
+} // namespace UT
+} // namespace SCONE
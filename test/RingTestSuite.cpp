@@ -0,0 +1,368 @@
+#include "src/Algorithms.h"
+#include "src/Ring.h"
+
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <deque>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+using namespace testing;
+
+template <typename T>
+class RingTestSuite : public ::testing::Test
+{
+};
+
+using RingTypes = ::testing::Types<CompactDeque<int>, InlineRing<int>, InlineRing<int, 16U>, CompactDeque<std::string>,
+                                   InlineRing<std::string, 8U>>;
+TYPED_TEST_SUITE(RingTestSuite, RingTypes);
+
+// Converts a number to the element type.
+template <typename T>
+T makeValue(const int value);
+
+template <>
+int makeValue<int>(const int value)
+{
+    return value;
+}
+
+template <>
+std::string makeValue<std::string>(const int value)
+{
+    return "long enough string to be allocated #" + std::to_string(value);
+}
+
+TYPED_TEST(RingTestSuite, testBothEnds)
+{
+    using T = typename TypeParam::value_type;
+    TypeParam testRing;
+    std::deque<T> expected;
+    EXPECT_TRUE(testRing.empty());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            testRing.push_front(makeValue<T>(i));
+            expected.push_front(makeValue<T>(i));
+        }
+        else
+        {
+            testRing.push_back(makeValue<T>(i));
+            expected.push_back(makeValue<T>(i));
+        }
+
+        if (i % 5 == 0)
+        {
+            testRing.pop_front();
+            expected.pop_front();
+        }
+        else if (i % 7 == 0)
+        {
+            testRing.pop_back();
+            expected.pop_back();
+        }
+
+        ASSERT_EQ(expected.size(), testRing.size());
+        if (!expected.empty())
+        {
+            ASSERT_EQ(expected.front(), testRing.front());
+            ASSERT_EQ(expected.back(), testRing.back());
+        }
+    }
+
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), testRing.begin(), testRing.end()));
+    EXPECT_EQ(0U, testRing.capacity() & (testRing.capacity() - 1U));
+}
+
+// Queue keeps its capacity when it's drained as fast as it's filled.
+TYPED_TEST(RingTestSuite, testWrapAround)
+{
+    using T = typename TypeParam::value_type;
+    TypeParam testRing;
+    testRing.reserve(8U);
+    const auto capacity = testRing.capacity();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        testRing.push_back(makeValue<T>(i));
+        if (testRing.size() == 3U)
+        {
+            ASSERT_EQ(makeValue<T>(i - 2), testRing.front());
+            testRing.pop_front();
+        }
+    }
+
+    EXPECT_EQ(capacity, testRing.capacity());
+    EXPECT_THAT(testRing, ElementsAre(makeValue<T>(98), makeValue<T>(99)));
+}
+
+// Elements keep the order when the buffer grows while they wrap around its end.
+TYPED_TEST(RingTestSuite, testGrowthWhileWrapped)
+{
+    using T = typename TypeParam::value_type;
+    TypeParam testRing;
+    std::vector<T> expected;
+    for (int i = 0; i < 3; ++i)
+    {
+        testRing.push_back(makeValue<T>(-1));
+        testRing.pop_front();
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        testRing.push_back(makeValue<T>(i));
+        expected.push_back(makeValue<T>(i));
+    }
+
+    EXPECT_EQ(100U, testRing.size());
+    EXPECT_LE(100U, testRing.capacity());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), testRing.begin(), testRing.end()));
+}
+
+TYPED_TEST(RingTestSuite, testSpans)
+{
+    using T = typename TypeParam::value_type;
+    TypeParam testRing;
+    testRing.reserve(16U);
+    EXPECT_EQ(0U, testRing.span().first.size());
+    EXPECT_EQ(0U, testRing.span().second.size());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        testRing.push_back(makeValue<T>(i));
+    }
+    testRing.pop_front(8U);
+    EXPECT_EQ(2U, testRing.size());
+    for (int i = 10; i < 20; ++i)
+    {
+        testRing.push_back(makeValue<T>(i));
+    }
+
+    // Elements from 8 to 19 wrap around the end of the buffer of 16 elements.
+    const auto& constRing = testRing;
+    const auto parts = constRing.span();
+    ASSERT_EQ(16U, testRing.capacity());
+    EXPECT_EQ(8U, parts.first.size());
+    EXPECT_EQ(4U, parts.second.size());
+    EXPECT_EQ(&testRing[0U], parts.first.data());
+    EXPECT_EQ(&testRing[8U], parts.second.data());
+
+    std::vector<T> drained(parts.first.begin(), parts.first.end());
+    drained.insert(drained.end(), parts.second.begin(), parts.second.end());
+    EXPECT_TRUE(std::equal(drained.begin(), drained.end(), testRing.begin(), testRing.end()));
+
+    // Elements from 18 are at the buffer start.
+    const auto tail = testRing.span(10U);
+    EXPECT_EQ(2U, tail.first.size());
+    EXPECT_EQ(0U, tail.second.size());
+    EXPECT_EQ(makeValue<T>(18), tail.first.data()[0]);
+
+    // Drained ring starts from the buffer start.
+    testRing.pop_front(testRing.size());
+    testRing.push_back(makeValue<T>(0));
+    EXPECT_EQ(1U, testRing.span().first.size());
+    EXPECT_EQ(0U, testRing.span().second.size());
+}
+
+// Elements of a full ring may be pushed to it, as the buffer is replaced after the new element is built.
+TYPED_TEST(RingTestSuite, testPushOwnElementWhenFull)
+{
+    using T = typename TypeParam::value_type;
+    TypeParam testRing;
+    std::deque<T> expected;
+    for (int i = 0; i < 20; ++i)
+    {
+        if (testRing.empty())
+        {
+            testRing.push_back(makeValue<T>(i));
+            expected.push_back(makeValue<T>(i));
+        }
+        else if (i % 2)
+        {
+            testRing.push_back(testRing.front());
+            expected.push_back(expected.front());
+        }
+        else
+        {
+            testRing.push_front(testRing.back());
+            expected.push_front(expected.back());
+        }
+    }
+
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), testRing.begin(), testRing.end()));
+}
+
+TYPED_TEST(RingTestSuite, testCopyAndMove)
+{
+    using T = typename TypeParam::value_type;
+    TypeParam testRing;
+    for (int i = 0; i < 10; ++i)
+    {
+        testRing.push_front(makeValue<T>(i));
+    }
+
+    auto copy = testRing;
+    EXPECT_EQ(testRing, copy);
+
+    TypeParam moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(testRing, moved);
+
+    moved.pop_back();
+    EXPECT_NE(testRing, moved);
+    moved = testRing;
+    EXPECT_EQ(testRing, moved);
+
+    TypeParam other = {makeValue<T>(1)};
+    other.swap(moved);
+    EXPECT_EQ(testRing, other);
+    EXPECT_THAT(moved, ElementsAre(makeValue<T>(1)));
+
+    // Inline elements are moved too.
+    TypeParam small = {makeValue<T>(1), makeValue<T>(2)};
+    small.pop_front();
+    small.push_back(makeValue<T>(3));
+    other = std::move(small);
+    EXPECT_THAT(other, ElementsAre(makeValue<T>(2), makeValue<T>(3)));
+
+    other.release();
+    EXPECT_TRUE(other.empty());
+    other.push_back(makeValue<T>(4));
+    EXPECT_THAT(other, ElementsAre(makeValue<T>(4)));
+}
+
+TEST(RingTestSuite, testFootprint)
+{
+    EXPECT_EQ(sizeof(void*), sizeof(CompactDeque<int>));
+    EXPECT_EQ(32U, sizeof(InlineRing<int>));
+}
+
+// Fails all allocations.
+class NullMemoryResource final : public MemoryResource
+{
+public:
+    void* allocate(size_t, size_t) override
+    {
+        throw std::bad_alloc();
+    }
+
+    void deallocate(void*, size_t, size_t) override
+    {
+    }
+};
+
+TEST(RingTestSuite, testInlineRingDoesntAllocate)
+{
+    NullMemoryResource resource;
+    pmr::InlineRing<int, 4U> testRing{PolymorphicAllocator<int>(&resource)};
+    for (int i = 0; i < 100; ++i)
+    {
+        testRing.push_back(i);
+        if (testRing.size() == 4U)
+        {
+            testRing.pop_front(2U);
+        }
+    }
+    EXPECT_EQ(4U, testRing.capacity());
+    EXPECT_THAT(testRing, ElementsAre(98, 99));
+
+    testRing.push_front(97);
+    testRing.push_back(100);
+    EXPECT_THROW(testRing.push_back(101), std::bad_alloc);
+    EXPECT_THAT(testRing, ElementsAre(97, 98, 99, 100));
+}
+
+// Counts live instances, moves throw if the source is marked.
+struct ThrowingMoveType
+{
+    explicit ThrowingMoveType(int& counter)
+        : counter(&counter)
+    {
+        ++counter;
+    }
+
+    ThrowingMoveType(const ThrowingMoveType& other)
+        : counter(other.counter)
+    {
+        ++(*counter);
+    }
+
+    ThrowingMoveType(ThrowingMoveType&& other)
+        : counter(other.counter)
+    {
+        if (other.shouldMoveThrow)
+        {
+            throw std::runtime_error("ThrowingMoveType");
+        }
+        ++(*counter);
+    }
+
+    ~ThrowingMoveType()
+    {
+        EXPECT_TRUE(alive);
+        alive = false;
+        --(*counter);
+    }
+
+    int* counter;
+    bool shouldMoveThrow = false;
+    bool alive = true;
+};
+
+// Failed move of inline elements leaves the source ring intact.
+TEST(RingTestSuite, testInlineMoveThrows)
+{
+    using TestRing = InlineRing<ThrowingMoveType, 4U>;
+    int objectsCounter = 0;
+    {
+        TestRing testRing;
+        for (int i = 0; i < 3; ++i)
+        {
+            testRing.emplace_back(objectsCounter);
+        }
+        testRing.pop_front();
+        testRing.emplace_back(objectsCounter);
+        testRing[1U].shouldMoveThrow = true;
+
+        EXPECT_THROW(TestRing moved(std::move(testRing)), std::runtime_error);
+        EXPECT_EQ(3U, testRing.size());
+        EXPECT_TRUE(std::all_of(testRing.begin(), testRing.end(), [](const ThrowingMoveType& item) { return item.alive; }));
+        EXPECT_EQ(3, objectsCounter);
+
+        testRing[1U].shouldMoveThrow = false;
+        TestRing moved(std::move(testRing));
+        EXPECT_TRUE(testRing.empty());
+        EXPECT_EQ(3U, moved.size());
+        EXPECT_EQ(3, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+TEST(RingTestSuite, testSpansWithAlgorithms)
+{
+    CompactDeque<uint32_t> testRing;
+    for (uint32_t i = 0U; i < 1000U; ++i)
+    {
+        testRing.push_back(i % 7U);
+        if (testRing.size() > 100U)
+        {
+            testRing.pop_front();
+        }
+    }
+
+    const auto parts = testRing.span();
+    EXPECT_EQ(static_cast<size_t>(std::count(testRing.begin(), testRing.end(), 3U)),
+              SCONE::count(parts.first, 3U) + SCONE::count(parts.second, 3U));
+}
+
+} // namespace UT
+} // namespace SCONE
@@ -0,0 +1,157 @@
+#include "src/SegmentedVector.h"
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+using namespace testing;
+
+TEST(SegmentedVectorTestSuite, testFootprint)
+{
+    EXPECT_EQ(sizeof(void*), sizeof(SegmentedVector<int>));
+}
+
+TEST(SegmentedVectorTestSuite, testPushBackKeepsAddresses)
+{
+    SegmentedVector<size_t> testArray;
+    std::vector<const size_t*> addresses;
+    for (size_t i = 0U; i < 100000U; ++i)
+    {
+        testArray.push_back(i);
+        addresses.push_back(&testArray.back());
+    }
+
+    ASSERT_EQ(100000U, testArray.size());
+    EXPECT_LE(testArray.size(), testArray.capacity());
+    for (size_t i = 0U; i < testArray.size(); ++i)
+    {
+        ASSERT_EQ(i, testArray[i]);
+        ASSERT_EQ(addresses[i], &testArray[i]);
+    }
+}
+
+TEST(SegmentedVectorTestSuite, testIterators)
+{
+    SegmentedVector<int> testArray;
+    for (int i = 0; i < 1000; ++i)
+    {
+        testArray.push_back(1000 - i);
+    }
+
+    EXPECT_EQ(1000, testArray.end() - testArray.begin());
+    EXPECT_EQ(500500, std::accumulate(testArray.cbegin(), testArray.cend(), 0));
+
+    std::sort(testArray.begin(), testArray.end());
+    EXPECT_TRUE(std::is_sorted(testArray.begin(), testArray.end()));
+    EXPECT_EQ(1, testArray.front());
+    EXPECT_EQ(1000, testArray.back());
+
+    const auto& constArray = testArray;
+    SegmentedVector<int>::const_iterator it = testArray.begin() + 10;
+    EXPECT_EQ(11, *it);
+    EXPECT_EQ(13, it[2]);
+    EXPECT_EQ(it, constArray.begin() + 10);
+    EXPECT_TRUE(it < constArray.end());
+}
+
+TEST(SegmentedVectorTestSuite, testSegments)
+{
+    SegmentedVector<uint32_t> testArray;
+    EXPECT_EQ(0U, testArray.segment_count());
+    for (uint32_t i = 0U; i < 10000U; ++i)
+    {
+        testArray.push_back(i % 7U);
+    }
+
+    size_t elements = 0U;
+    size_t sevens = 0U;
+    size_t threes = 0U;
+    const auto completed = testArray.for_each_segment([&](const SegmentedVector<uint32_t>::const_segment& segment) {
+        EXPECT_EQ(&testArray[elements], segment.data());
+        elements += segment.size();
+        sevens += SCONE::count(segment, 7U);
+        threes += SCONE::count(segment, 3U);
+        return true;
+    });
+
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(testArray.size(), elements);
+    EXPECT_EQ(0U, sevens);
+    EXPECT_EQ(std::count(testArray.begin(), testArray.end(), 3U), static_cast<ptrdiff_t>(threes));
+
+    // Segments double in size.
+    for (size_t i = 1U; i + 1U < testArray.segment_count(); ++i)
+    {
+        EXPECT_EQ(2U * testArray.get_segment(i - 1U).size(), testArray.get_segment(i).size());
+    }
+}
+
+TEST(SegmentedVectorTestSuite, testReserveAndShrink)
+{
+    SegmentedVector<int> testArray = {1, 2, 3};
+    const auto* first = &testArray.front();
+    testArray.reserve(10000U);
+    EXPECT_LE(10000U, testArray.capacity());
+    EXPECT_EQ(first, &testArray.front());
+
+    testArray.shrink_to_fit();
+    EXPECT_GT(10000U, testArray.capacity());
+    EXPECT_EQ(first, &testArray.front());
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+
+    testArray.clear();
+    EXPECT_TRUE(testArray.empty());
+    testArray.shrink_to_fit();
+    EXPECT_EQ(0U, testArray.capacity());
+}
+
+TEST(SegmentedVectorTestSuite, testCopyAndMove)
+{
+    SegmentedVector<std::string> testArray;
+    for (int i = 0; i < 100; ++i)
+    {
+        testArray.emplace_back("long enough string to be allocated #" + std::to_string(i));
+    }
+
+    auto copy = testArray;
+    EXPECT_EQ(testArray, copy);
+
+    const auto* first = &copy.front();
+    SegmentedVector<std::string> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(first, &moved.front());
+    EXPECT_EQ(testArray, moved);
+
+    moved.pop_back();
+    EXPECT_NE(testArray, moved);
+    moved = testArray;
+    EXPECT_EQ(testArray, moved);
+
+    SegmentedVector<std::string> other = {"a"};
+    other.swap(moved);
+    EXPECT_EQ(testArray, other);
+    EXPECT_THAT(moved, ElementsAre("a"));
+}
+
+TEST(SegmentedVectorTestSuite, testPolymorphicAllocator)
+{
+    pmr::SegmentedVector<int> testArray{PolymorphicAllocator<int>()};
+    for (int i = 0; i < 1000; ++i)
+    {
+        testArray.push_back(i);
+    }
+    EXPECT_EQ(999, testArray.back());
+    EXPECT_EQ(2U * sizeof(void*), sizeof(testArray));
+}
+
+} // namespace UT
+} // namespace SCONE
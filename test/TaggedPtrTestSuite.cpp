@@ -3,6 +3,7 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <memory>
 
 namespace SCONE
@@ -14,7 +15,7 @@ TEST(TaggedPtrTestSuite, testHeapPtr)
 {
     auto heapPtr = std::make_unique<int>(10);
 
-    TaggedPtr ptr(heapPtr.get());
+    TaggedPtr<> ptr(heapPtr.get());
     EXPECT_FALSE(ptr.hasFlag());
 
     ptr.setFlag(true);
@@ -26,12 +27,123 @@ TEST(TaggedPtrTestSuite, testStackPtr)
 {
     int stackPtr = 1;
 
-    TaggedPtr ptr(&stackPtr);
+    TaggedPtr<> ptr(&stackPtr);
     EXPECT_FALSE(ptr.hasFlag());
 
     ptr.setFlag(true);
     EXPECT_TRUE(ptr.hasFlag());
     EXPECT_EQ(&stackPtr, ptr.getAs<int>());
 }
+
+TEST(TaggedPtrTestSuite, testLowTag)
+{
+    auto heapPtr = std::make_unique<uint64_t>(10U);
+
+    TaggedPtr<3> ptr(heapPtr.get());
+    EXPECT_EQ(0U, ptr.getLowTag());
+
+    ptr.setLowTag(5U);
+    EXPECT_EQ(5U, ptr.getLowTag());
+    EXPECT_TRUE(ptr.hasFlag());
+    EXPECT_EQ(heapPtr.get(), ptr.getAs<uint64_t>());
+
+    ptr.setFlag(false);
+    EXPECT_EQ(4U, ptr.getLowTag());
+
+    // Assignment resets the tag, setPtr keeps it.
+    auto otherPtr = std::make_unique<uint64_t>(20U);
+    ptr.setPtr(otherPtr.get());
+    EXPECT_EQ(4U, ptr.getLowTag());
+    EXPECT_EQ(otherPtr.get(), ptr.getAs<uint64_t>());
+
+    ptr = heapPtr.get();
+    EXPECT_EQ(0U, ptr.getLowTag());
+}
+
+TEST(TaggedPtrTestSuite, testHighTag)
+{
+    if (sizeof(void*) != 8U)
+    {
+        GTEST_SKIP();
+    }
+
+    auto heapPtr = std::make_unique<uint32_t>(10U);
+
+    TaggedPtr<2, 16> ptr(heapPtr.get());
+    EXPECT_EQ(18U, ptr.TagBits);
+
+    ptr.setHighTag(0xBEEFU);
+    ptr.setLowTag(3U);
+    EXPECT_EQ(0xBEEFU, ptr.getHighTag());
+    EXPECT_EQ(3U, ptr.getLowTag());
+    EXPECT_EQ((0xBEEFU << 2U) | 3U, ptr.getTag());
+    EXPECT_EQ(heapPtr.get(), ptr.getAs<uint32_t>());
+    EXPECT_EQ(10U, *ptr.getAs<uint32_t>());
+
+    ptr.setTag(0x3FFFFU);
+    EXPECT_EQ(0xFFFFU, ptr.getHighTag());
+    EXPECT_EQ(3U, ptr.getLowTag());
+    EXPECT_EQ(heapPtr.get(), ptr.getAs<uint32_t>());
+}
+
+TEST(TaggedPtrTestSuite, testNull)
+{
+    TaggedPtr<2> ptr;
+    EXPECT_FALSE(ptr);
+
+    ptr.setLowTag(2U);
+    EXPECT_FALSE(ptr);
+    EXPECT_EQ(nullptr, ptr.getAs<int>());
+}
+
+TEST(TaggedPtrTestSuite, testUnion)
+{
+    auto intPtr = std::make_unique<int>(1);
+    auto doublePtr = std::make_unique<double>(2.0);
+
+    TaggedPtrUnion<int, double, int64_t> ptr;
+    EXPECT_FALSE(ptr);
+    EXPECT_FALSE(ptr.is<int>());
+
+    ptr = intPtr.get();
+    EXPECT_TRUE(ptr.is<int>());
+    EXPECT_FALSE(ptr.is<double>());
+    EXPECT_EQ(intPtr.get(), ptr.get<int>());
+    EXPECT_EQ(nullptr, ptr.getIf<double>());
+
+    ptr = doublePtr.get();
+    EXPECT_TRUE(ptr.is<double>());
+    EXPECT_EQ(doublePtr.get(), ptr.getIf<double>());
+    EXPECT_EQ(nullptr, ptr.getIf<int>());
+}
+
+TEST(TaggedPtrTestSuite, testAtomic)
+{
+    auto first = std::make_unique<uint64_t>(1U);
+    auto second = std::make_unique<uint64_t>(2U);
+
+    TaggedPtr<2U, 8U> ptr(first.get());
+    ptr.setTag(0x123U);
+    AtomicTaggedPtr<2U, 8U> atomicPtr(ptr);
+    EXPECT_TRUE(atomicPtr.isLockFree());
+    EXPECT_EQ(ptr, atomicPtr.load());
+
+    // Exchange fails if only the tag differs.
+    auto expected = ptr;
+    expected.setTag(0x124U);
+    TaggedPtr<2U, 8U> desired(second.get());
+    desired.setTag(0x3FFU);
+    EXPECT_FALSE(atomicPtr.compareExchange(expected, desired));
+    EXPECT_EQ(ptr, expected);
+
+    EXPECT_TRUE(atomicPtr.compareExchange(expected, desired));
+    EXPECT_EQ(second.get(), atomicPtr.load().getAs<uint64_t>());
+    EXPECT_EQ(0x3FFU, atomicPtr.load().getTag());
+
+    EXPECT_EQ(desired, atomicPtr.exchange(nullptr));
+    atomicPtr.store(ptr, std::memory_order_release);
+    EXPECT_EQ(ptr, atomicPtr.load(std::memory_order_acquire));
+}
+
 } // namespace UT
 } // namespace SCONE
@@ -0,0 +1,104 @@
+#include "src/MallocAllocator.h"
+#include "src/Vector.h"
+
+#include <gmock/gmock.h>
+
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace SCONE
+{
+namespace UT
+{
+using namespace testing;
+
+template <typename T>
+class TaggedVectorTestSuite : public ::testing::Test
+{
+};
+
+using TaggedVectorTypes = ::testing::Types<TaggedVector<int>, TaggedVector<int, MallocAllocator<int>>>;
+TYPED_TEST_SUITE(TaggedVectorTestSuite, TaggedVectorTypes);
+
+TYPED_TEST(TaggedVectorTestSuite, testSize)
+{
+    EXPECT_EQ(sizeof(void*), sizeof(TypeParam));
+}
+
+TYPED_TEST(TaggedVectorTestSuite, testPushBackCapacities)
+{
+    TypeParam testArray;
+    EXPECT_TRUE(testArray.empty());
+    EXPECT_EQ(0U, testArray.capacity());
+
+    std::vector<size_t> capacities;
+    for (int i = 0; i < 5; ++i)
+    {
+        testArray.push_back(i);
+        capacities.push_back(testArray.capacity());
+    }
+    // Small buffers have power of two capacities.
+    EXPECT_THAT(capacities, ElementsAre(1, 4, 4, 4, 8));
+    EXPECT_THAT(testArray, ElementsAre(0, 1, 2, 3, 4));
+}
+
+TYPED_TEST(TaggedVectorTestSuite, testSmallToLarge)
+{
+    const auto maxSmallCapacity = VectorDetails::TaggedSizeStorage<int>::MaxSmallCapacity;
+
+    std::vector<int> expected(maxSmallCapacity + 1U);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    TypeParam testArray;
+    for (size_t i = 0U; i < maxSmallCapacity; ++i)
+    {
+        testArray.push_back(expected[i]);
+    }
+    EXPECT_EQ(maxSmallCapacity, testArray.size());
+    EXPECT_EQ(maxSmallCapacity, testArray.capacity());
+
+    testArray.push_back(expected.back());
+    EXPECT_EQ(maxSmallCapacity + 1U, testArray.size());
+    EXPECT_LT(maxSmallCapacity, testArray.capacity());
+    EXPECT_THAT(testArray, ElementsAreArray(expected));
+
+    testArray.erase(testArray.begin(), testArray.begin() + maxSmallCapacity);
+    EXPECT_THAT(testArray, ElementsAre(expected.back()));
+}
+
+TYPED_TEST(TaggedVectorTestSuite, testInsertErase)
+{
+    TypeParam testArray = {1, 2, 3, 4, 5};
+    EXPECT_EQ(5U, testArray.size());
+    EXPECT_EQ(8U, testArray.capacity());
+
+    testArray.insert(testArray.begin() + 2U, 6);
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 6, 3, 4, 5));
+
+    testArray.erase(testArray.begin(), testArray.begin() + 3U);
+    EXPECT_THAT(testArray, ElementsAre(3, 4, 5));
+
+    testArray.pop_back();
+    EXPECT_THAT(testArray, ElementsAre(3, 4));
+}
+
+TYPED_TEST(TaggedVectorTestSuite, testCopyMoveSwap)
+{
+    TypeParam testArray = {1, 2, 3};
+    TypeParam copyArray(testArray);
+    EXPECT_THAT(copyArray, ElementsAre(1, 2, 3));
+
+    TypeParam movedArray(std::move(testArray));
+    EXPECT_TRUE(testArray.empty());
+    EXPECT_TRUE(std::is_nothrow_move_constructible<TypeParam>::value);
+    EXPECT_THAT(movedArray, ElementsAre(1, 2, 3));
+
+    TypeParam otherArray = {4};
+    otherArray.swap(movedArray);
+    EXPECT_THAT(otherArray, ElementsAre(1, 2, 3));
+    EXPECT_THAT(movedArray, ElementsAre(4));
+}
+
+} // namespace UT
+} // namespace SCONE
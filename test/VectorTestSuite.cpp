@@ -1,8 +1,13 @@
+#include "src/MallocAllocator.h"
 #include "src/Vector.h"
 
 #include <gmock/gmock.h>
 
+#include <cstring>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace SCONE
@@ -16,15 +21,33 @@ class VectorTestSuiteFundamentalType : public ::testing::Test
 {
 };
 
-using VectorFundamentalTypes = ::testing::Types<CompactVector<int>, InlineVector<int>>;
+using VectorFundamentalTypes = ::testing::Types<CompactVector<int>,
+                                                InlineVector<int>,
+                                                CompactVector<int, MallocAllocator<int>>,
+                                                PackedInlineVector<int, 24U>,
+                                                SharedCompactVector<int>>;
 TYPED_TEST_SUITE(VectorTestSuiteFundamentalType, VectorFundamentalTypes);
 
+// Allocators which report usable size of blocks may give more capacity than requested.
+template <typename VectorType>
+void expectCapacity(const size_t expected, const VectorType& vector)
+{
+    if (HasAllocateAtLeast<typename VectorType::allocator_type>::value)
+    {
+        EXPECT_LE(expected, vector.capacity());
+    }
+    else
+    {
+        EXPECT_EQ(expected, vector.capacity());
+    }
+}
+
 TYPED_TEST(VectorTestSuiteFundamentalType, testConstruction)
 {
     std::vector<int> intArray = {1, 2, 3, 5, 4};
     TypeParam testArray(intArray);
     EXPECT_EQ(intArray.size(), testArray.size());
-    EXPECT_EQ(5U, testArray.capacity());
+    expectCapacity(5U, testArray);
     EXPECT_THAT(testArray, ElementsAreArray(intArray));
     EXPECT_TRUE(std::equal(intArray.rbegin(), intArray.rend(), testArray.rbegin()));
     EXPECT_NE(testArray.begin(), testArray.end());
@@ -43,24 +66,56 @@ TYPED_TEST(VectorTestSuiteFundamentalType, testReserve)
 {
     auto intArray = {1, 2, 3, 5, 4};
     TypeParam testArray(intArray);
-    EXPECT_EQ(5U, testArray.capacity());
+    expectCapacity(5U, testArray);
 
     testArray.reserve(1);
     EXPECT_EQ(5U, testArray.size());
-    EXPECT_EQ(5U, testArray.capacity());
+    expectCapacity(5U, testArray);
 
     testArray.reserve(10);
     EXPECT_EQ(5U, testArray.size());
-    EXPECT_EQ(10U, testArray.capacity());
+    expectCapacity(10U, testArray);
     EXPECT_THAT(testArray, ElementsAreArray(intArray));
 
     auto longCapacity = std::numeric_limits<uint16_t>::max() + 1U;
     testArray.reserve(longCapacity);
     EXPECT_EQ(5U, testArray.size());
-    EXPECT_EQ(longCapacity, testArray.capacity());
+    expectCapacity(longCapacity, testArray);
     EXPECT_THAT(testArray, ElementsAreArray(intArray));
 }
 
+TYPED_TEST(VectorTestSuiteFundamentalType, testClearKeepsCapacity)
+{
+    TypeParam testArray = {1, 2, 3, 5, 4};
+    testArray.reserve(10U);
+    const auto* data = testArray.begin();
+
+    testArray.clear();
+    EXPECT_TRUE(testArray.empty());
+    expectCapacity(10U, testArray);
+
+    testArray.push_back(6);
+    EXPECT_EQ(data, testArray.begin());
+    EXPECT_THAT(testArray, ElementsAre(6));
+
+    testArray.release();
+    EXPECT_TRUE(testArray.empty());
+    EXPECT_EQ(TypeParam().capacity(), testArray.capacity());
+}
+
+TYPED_TEST(VectorTestSuiteFundamentalType, testShrinkToFit)
+{
+    TypeParam testArray = {1, 2, 3, 5, 4};
+    testArray.reserve(100U);
+    testArray.shrink_to_fit();
+    expectCapacity(5U, testArray);
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3, 5, 4));
+
+    testArray.clear();
+    testArray.shrink_to_fit();
+    EXPECT_EQ(TypeParam().capacity(), testArray.capacity());
+}
+
 TYPED_TEST(VectorTestSuiteFundamentalType, testCopy)
 {
     auto intArray = {1, 2, 3, 5, 4};
@@ -80,6 +135,9 @@ TYPED_TEST(VectorTestSuiteFundamentalType, testMove)
     TypeParam movedArray(std::move(testArray));
     EXPECT_THAT(movedArray, ElementsAreArray(intArray));
     EXPECT_EQ(0U, testArray.size()); // Container must be in empty state after move.
+
+    // Containers of vectors move them on growth instead of copying.
+    EXPECT_TRUE(std::is_nothrow_move_constructible<TypeParam>::value);
 }
 
 template <typename VectorType>
@@ -94,6 +152,12 @@ std::vector<int> getCapacities<InlineVector<int, 1>>()
     return {1, 1, 3, 3};
 }
 
+template <>
+std::vector<int> getCapacities<PackedInlineVector<int, 24U>>()
+{
+    return {5, 5, 5, 5};
+}
+
 TYPED_TEST(VectorTestSuiteFundamentalType, testPushBack)
 {
     const auto& capacities = getCapacities<TypeParam>();
@@ -101,21 +165,21 @@ TYPED_TEST(VectorTestSuiteFundamentalType, testPushBack)
 
     TypeParam testArray;
     EXPECT_EQ(0U, testArray.size());
-    EXPECT_EQ(capacities[0], testArray.capacity());
+    expectCapacity(capacities[0], testArray);
 
     testArray.push_back(5);
     EXPECT_EQ(1U, testArray.size());
-    EXPECT_EQ(capacities[1], testArray.capacity());
+    expectCapacity(capacities[1], testArray);
     EXPECT_EQ(5, testArray[0U]);
 
     testArray.push_back(2);
     EXPECT_EQ(2U, testArray.size());
-    EXPECT_EQ(capacities[2], testArray.capacity());
+    expectCapacity(capacities[2], testArray);
     EXPECT_EQ(2, testArray[1U]);
 
     testArray.push_back(1);
     EXPECT_EQ(3U, testArray.size());
-    EXPECT_EQ(capacities[3], testArray.capacity());
+    expectCapacity(capacities[3], testArray);
     EXPECT_EQ(1, testArray[2U]);
 }
 
@@ -178,6 +242,112 @@ TYPED_TEST(VectorTestSuiteFundamentalType, testInsertRange)
     }
 }
 
+TYPED_TEST(VectorTestSuiteFundamentalType, testEmplace)
+{
+    TypeParam testArray;
+    auto& item = testArray.emplace_back(1);
+    EXPECT_EQ(&testArray.back(), &item);
+
+    // Arguments may refer to elements, which are moved on growth.
+    for (int i = 0; i < 10; ++i)
+    {
+        testArray.emplace_back(testArray.front());
+    }
+    EXPECT_EQ(11U, testArray.size());
+    EXPECT_TRUE(std::all_of(testArray.begin(), testArray.end(), [](int value) { return value == 1; }));
+
+    auto it = testArray.emplace(testArray.begin() + 1U, 2);
+    EXPECT_EQ(testArray.begin() + 1U, it);
+    EXPECT_EQ(2, *it);
+
+    testArray.emplace(testArray.begin(), testArray[1U]);
+    EXPECT_EQ(2, testArray[0U]);
+    EXPECT_EQ(1, testArray[1U]);
+    EXPECT_EQ(2, testArray[2U]);
+    EXPECT_EQ(13U, testArray.size());
+}
+
+TYPED_TEST(VectorTestSuiteFundamentalType, testResize)
+{
+    TypeParam testArray = {1, 2, 3};
+    testArray.resize(5U);
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3, 0, 0));
+
+    testArray.resize(7U, testArray.front());
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3, 0, 0, 1, 1));
+
+    testArray.resize(2U);
+    EXPECT_THAT(testArray, ElementsAre(1, 2));
+
+    testArray.resize_default_init(4U);
+    EXPECT_EQ(4U, testArray.size());
+    EXPECT_EQ(2, testArray[1U]);
+
+    testArray.resize(0U);
+    EXPECT_TRUE(testArray.empty());
+}
+
+TYPED_TEST(VectorTestSuiteFundamentalType, testAssignAppend)
+{
+    const std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    TypeParam testArray = {1, 2, 3};
+    testArray.reserve(5U);
+    testArray.assign(values.begin(), values.begin() + 4U);
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3, 4));
+    expectCapacity(5U, testArray);
+
+    testArray.assign(values.begin(), values.end());
+    EXPECT_THAT(testArray, ElementsAreArray(values));
+    expectCapacity(10U, testArray);
+
+    testArray.append(values.begin(), values.begin() + 2U);
+    EXPECT_EQ(12U, testArray.size());
+    EXPECT_EQ(2, testArray.back());
+}
+
+TYPED_TEST(VectorTestSuiteFundamentalType, testEraseIf)
+{
+    TypeParam testArray = {1, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_EQ(4U, testArray.erase_if([](int value) { return value % 2 == 0; }));
+    EXPECT_THAT(testArray, ElementsAre(1, 3, 5, 7));
+
+    EXPECT_EQ(0U, testArray.erase_if([](int value) { return value > 10; }));
+    EXPECT_THAT(testArray, ElementsAre(1, 3, 5, 7));
+
+    EXPECT_EQ(4U, testArray.erase_if([](int) { return true; }));
+    EXPECT_TRUE(testArray.empty());
+    EXPECT_EQ(0U, testArray.erase_if([](int) { return true; }));
+}
+
+TYPED_TEST(VectorTestSuiteFundamentalType, testSwapRemove)
+{
+    TypeParam testArray = {1, 2, 3, 4};
+    auto it = testArray.swap_remove(testArray.begin());
+    EXPECT_EQ(testArray.begin(), it);
+    EXPECT_THAT(testArray, ElementsAre(4, 2, 3));
+
+    it = testArray.swap_remove(testArray.end() - 1);
+    EXPECT_EQ(testArray.end(), it);
+    EXPECT_THAT(testArray, ElementsAre(4, 2));
+}
+
+TYPED_TEST(VectorTestSuiteFundamentalType, testInsertBatch)
+{
+    TypeParam testArray = {1, 2, 3, 4};
+    const size_t indices[] = {0U, 2U, 2U, 4U};
+    const int values[] = {10, 20, 21, 40};
+    testArray.insert_batch(std::begin(indices), std::end(indices), std::begin(values));
+    EXPECT_THAT(testArray, ElementsAre(10, 1, 2, 20, 21, 3, 4, 40));
+
+    testArray.insert_batch(std::begin(indices), std::begin(indices), std::begin(values));
+    EXPECT_EQ(8U, testArray.size());
+
+    TypeParam emptyArray;
+    emptyArray.insert_batch(std::begin(indices), std::begin(indices) + 1U, std::begin(values));
+    EXPECT_THAT(emptyArray, ElementsAre(10));
+}
+
 TYPED_TEST(VectorTestSuiteFundamentalType, testFrontBack)
 {
     TypeParam testArray = {1, 2, 3, 4, 5};
@@ -264,7 +434,10 @@ class VectorTestSuiteClassType : public ::testing::Test
 {
 };
 
-using VectorTypes = ::testing::Types<CompactVector<TestType>, InlineVector<TestType>>;
+using VectorTypes = ::testing::Types<CompactVector<TestType>,
+                                    InlineVector<TestType>,
+                                    PackedInlineVector<TestType>,
+                                    SharedCompactVector<TestType>>;
 TYPED_TEST_SUITE(VectorTestSuiteClassType, VectorTypes);
 
 TYPED_TEST(VectorTestSuiteClassType, testConstruction)
@@ -296,6 +469,54 @@ TYPED_TEST(VectorTestSuiteClassType, testExceptionSafety)
     EXPECT_EQ(0, objectsCounter);
 }
 
+TYPED_TEST(VectorTestSuiteClassType, testResize)
+{
+    int objectsCounter = 0;
+    {
+        TypeParam testArray;
+        testArray.resize(10U, TestType(objectsCounter));
+        EXPECT_EQ(10U, testArray.size());
+        EXPECT_EQ(10, objectsCounter);
+
+        testArray.resize(3U, TestType(objectsCounter));
+        EXPECT_EQ(3U, testArray.size());
+        EXPECT_EQ(3, objectsCounter);
+
+        TestType throwingValue(objectsCounter);
+        throwingValue.shouldCopyCtorThrow = true;
+        EXPECT_THROW(testArray.resize(5U, throwingValue), std::runtime_error);
+        EXPECT_EQ(3U, testArray.size());
+        EXPECT_EQ(4, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+TYPED_TEST(VectorTestSuiteClassType, testBulkMutation)
+{
+    int objectsCounter = 0;
+    {
+        TypeParam testArray;
+        testArray.resize(6U, TestType(objectsCounter));
+        EXPECT_EQ(6, objectsCounter);
+
+        int index = 0;
+        EXPECT_EQ(3U, testArray.erase_if([&index](const TestType&) { return index++ % 2 == 0; }));
+        EXPECT_EQ(3U, testArray.size());
+        EXPECT_EQ(3, objectsCounter);
+
+        testArray.swap_remove(testArray.begin());
+        EXPECT_EQ(2U, testArray.size());
+        EXPECT_EQ(2, objectsCounter);
+
+        const size_t indices[] = {0U, 1U, 2U};
+        const TestType values[] = {TestType(objectsCounter), TestType(objectsCounter), TestType(objectsCounter)};
+        testArray.insert_batch(std::begin(indices), std::end(indices), std::begin(values));
+        EXPECT_EQ(5U, testArray.size());
+        EXPECT_EQ(8, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
 TYPED_TEST(VectorTestSuiteClassType, testMove)
 {
     int objectsCounter = 0;
@@ -338,5 +559,1104 @@ TYPED_TEST(VectorTestSuiteClassType, testInsertRangeWithException)
     EXPECT_EQ(0U, objectsCounter);
 }
 
+struct CopyCountingType
+{
+    CopyCountingType(int value, int& copies)
+        : value(value)
+        , copies(copies)
+    {
+    }
+
+    CopyCountingType(const CopyCountingType& other)
+        : value(other.value)
+        , copies(other.copies)
+    {
+        ++(copies.get());
+    }
+
+    CopyCountingType& operator=(const CopyCountingType& other)
+    {
+        value = other.value;
+        ++(copies.get());
+        return *this;
+    }
+
+    int value;
+    std::reference_wrapper<int> copies;
+};
+
+template <typename T>
+class VectorEmplaceTestSuite : public ::testing::Test
+{
+};
+
+using EmplaceVectorTypes = ::testing::Types<CompactVector<CopyCountingType>,
+                                            InlineVector<CopyCountingType, 2>,
+                                            PackedInlineVector<CopyCountingType, 48U>,
+                                            TaggedVector<CopyCountingType>,
+                                            SharedCompactVector<CopyCountingType>>;
+TYPED_TEST_SUITE(VectorEmplaceTestSuite, EmplaceVectorTypes);
+
+TYPED_TEST(VectorEmplaceTestSuite, testEmplaceBackWithoutTemporaries)
+{
+    int copies = 0;
+    TypeParam testArray;
+    testArray.reserve(100U);
+    const auto capacity = static_cast<int>(testArray.capacity());
+    for (int i = 0; i < capacity; ++i)
+    {
+        EXPECT_EQ(i, testArray.emplace_back(i, copies).value);
+    }
+    EXPECT_EQ(0, copies);
+
+    // Growth copies only existing elements.
+    testArray.emplace_back(capacity, copies);
+    EXPECT_EQ(capacity, copies);
+    EXPECT_EQ(capacity, testArray.back().value);
+}
+
+TYPED_TEST(VectorEmplaceTestSuite, testEmplaceWithGrowth)
+{
+    int copies = 0;
+    TypeParam testArray;
+    testArray.emplace_back(1, copies);
+    testArray.emplace_back(3, copies);
+    testArray.shrink_to_fit();
+    copies = 0;
+
+    auto it = testArray.emplace(testArray.begin() + 1U, 2, copies);
+    EXPECT_EQ(2, it->value);
+    EXPECT_EQ(2, copies);
+
+    std::vector<int> values;
+    for (const auto& item : testArray)
+    {
+        values.push_back(item.value);
+    }
+    EXPECT_THAT(values, ElementsAre(1, 2, 3));
+}
+
+// Owns heap memory through a raw pointer, so it is not trivially copyable, but is safe to relocate with memcpy.
+struct RelocatableTestType
+{
+    RelocatableTestType(int value, int& liveObjCounter)
+        : _value(new int(value))
+        , _liveObjCounter(&liveObjCounter)
+    {
+        ++(*_liveObjCounter);
+    }
+
+    RelocatableTestType(const RelocatableTestType& other)
+        : _value(new int(*other._value))
+        , _liveObjCounter(other._liveObjCounter)
+    {
+        ++(*_liveObjCounter);
+    }
+
+    RelocatableTestType& operator=(const RelocatableTestType& other)
+    {
+        *_value = *other._value;
+        return *this;
+    }
+
+    ~RelocatableTestType()
+    {
+        delete _value;
+        --(*_liveObjCounter);
+    }
+
+    int value() const
+    {
+        return *_value;
+    }
+
+private:
+    int* _value;
+    int* _liveObjCounter;
+};
+} // namespace UT
+
+template <>
+struct IsTriviallyRelocatable<UT::RelocatableTestType> : std::true_type
+{
+};
+
+namespace UT
+{
+
+template <typename T>
+class VectorTestSuiteRelocatableType : public ::testing::Test
+{
+};
+
+using RelocatableVectorTypes = ::testing::Types<CompactVector<RelocatableTestType>,
+                                                InlineVector<RelocatableTestType, 2>,
+                                                CompactVector<RelocatableTestType, MallocAllocator<RelocatableTestType>>,
+                                                InlineVector<RelocatableTestType, 2, MallocAllocator<RelocatableTestType>>,
+                                                PackedInlineVector<RelocatableTestType, 48U>,
+                                                PackedInlineVector<RelocatableTestType, 48U, MallocAllocator<RelocatableTestType>>,
+                                                TaggedVector<RelocatableTestType>,
+                                                SharedCompactVector<RelocatableTestType>>;
+TYPED_TEST_SUITE(VectorTestSuiteRelocatableType, RelocatableVectorTypes);
+
+template <typename VectorType>
+std::vector<int> getValues(const VectorType& vector)
+{
+    std::vector<int> result;
+    for (const auto& item : vector)
+    {
+        result.push_back(item.value());
+    }
+    return result;
+}
+
+TYPED_TEST(VectorTestSuiteRelocatableType, testGrowth)
+{
+    int objectsCounter = 0;
+    {
+        TypeParam testArray;
+        for (int i = 0; i < 100; ++i)
+        {
+            testArray.push_back(RelocatableTestType(i, objectsCounter));
+        }
+        EXPECT_EQ(100U, testArray.size());
+        EXPECT_EQ(100, objectsCounter);
+        EXPECT_EQ(0, testArray.front().value());
+        EXPECT_EQ(99, testArray.back().value());
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+TYPED_TEST(VectorTestSuiteRelocatableType, testInsertErase)
+{
+    int objectsCounter = 0;
+    {
+        TypeParam testArray = {RelocatableTestType(1, objectsCounter), RelocatableTestType(2, objectsCounter)};
+        testArray.reserve(10U);
+
+        testArray.insert(testArray.begin() + 1U, RelocatableTestType(3, objectsCounter));
+        EXPECT_THAT(getValues(testArray), ElementsAre(1, 3, 2));
+
+        RelocatableTestType array[] = {RelocatableTestType(4, objectsCounter), RelocatableTestType(5, objectsCounter)};
+        testArray.insert(testArray.begin(), array, array + 2U);
+        EXPECT_THAT(getValues(testArray), ElementsAre(4, 5, 1, 3, 2));
+        EXPECT_EQ(7, objectsCounter);
+
+        auto result = testArray.erase(testArray.begin() + 1U, testArray.begin() + 3U);
+        EXPECT_EQ(3, result->value());
+        EXPECT_THAT(getValues(testArray), ElementsAre(4, 3, 2));
+        EXPECT_EQ(5, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+TYPED_TEST(VectorTestSuiteRelocatableType, testMove)
+{
+    int objectsCounter = 0;
+    {
+        TypeParam testArray = {RelocatableTestType(1, objectsCounter)};
+        TypeParam movedArray(std::move(testArray));
+        EXPECT_EQ(0U, testArray.size());
+        EXPECT_THAT(getValues(movedArray), ElementsAre(1));
+        EXPECT_EQ(1, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+TYPED_TEST(VectorTestSuiteRelocatableType, testEmplace)
+{
+    int objectsCounter = 0;
+    {
+        TypeParam testArray;
+        for (int i = 0; i < 10; ++i)
+        {
+            EXPECT_EQ(i, testArray.emplace_back(i, objectsCounter).value());
+        }
+        EXPECT_EQ(10, objectsCounter);
+
+        auto it = testArray.emplace(testArray.begin() + 2U, 42, objectsCounter);
+        EXPECT_EQ(42, it->value());
+        EXPECT_EQ(11, objectsCounter);
+
+        testArray.emplace(testArray.begin(), testArray.back());
+        EXPECT_EQ(9, testArray.front().value());
+        EXPECT_EQ(12, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+TYPED_TEST(VectorTestSuiteRelocatableType, testBulkMutation)
+{
+    int objectsCounter = 0;
+    {
+        TypeParam testArray;
+        for (int i = 0; i < 10; ++i)
+        {
+            testArray.emplace_back(i, objectsCounter);
+        }
+
+        EXPECT_EQ(5U, testArray.erase_if([](const RelocatableTestType& item) { return item.value() % 2 == 1; }));
+        EXPECT_THAT(getValues(testArray), ElementsAre(0, 2, 4, 6, 8));
+        EXPECT_EQ(5, objectsCounter);
+
+        // Vector stays consistent if the predicate throws.
+        EXPECT_THROW(testArray.erase_if([](const RelocatableTestType& item) {
+            if (item.value() == 6)
+            {
+                throw std::runtime_error("");
+            }
+            return item.value() == 2;
+        }),
+                     std::runtime_error);
+        EXPECT_THAT(getValues(testArray), ElementsAre(0, 4, 6, 8));
+        EXPECT_EQ(4, objectsCounter);
+
+        testArray.swap_remove(testArray.begin() + 1U);
+        EXPECT_THAT(getValues(testArray), ElementsAre(0, 8, 6));
+        EXPECT_EQ(3, objectsCounter);
+
+        const size_t indices[] = {1U, 3U};
+        const RelocatableTestType values[] = {RelocatableTestType(1, objectsCounter), RelocatableTestType(9, objectsCounter)};
+        testArray.insert_batch(std::begin(indices), std::end(indices), std::begin(values));
+        EXPECT_THAT(getValues(testArray), ElementsAre(0, 1, 8, 6, 9));
+        EXPECT_EQ(7, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+TYPED_TEST(VectorTestSuiteRelocatableType, testShrinkToFit)
+{
+    int objectsCounter = 0;
+    {
+        TypeParam testArray;
+        for (int i = 0; i < 100; ++i)
+        {
+            testArray.push_back(RelocatableTestType(i, objectsCounter));
+        }
+
+        testArray.erase(testArray.begin() + 10U, testArray.end());
+        testArray.shrink_to_fit();
+        EXPECT_LE(10U, testArray.capacity());
+        EXPECT_GT(100U, testArray.capacity());
+        EXPECT_EQ(10, objectsCounter);
+        EXPECT_EQ(9, testArray.back().value());
+
+        // Fits into the inline buffer of InlineVector and the smallest buffer of other vectors.
+        testArray.erase(testArray.begin() + 2U, testArray.end());
+        testArray.shrink_to_fit();
+        EXPECT_EQ(2U, testArray.capacity());
+        EXPECT_THAT(getValues(testArray), ElementsAre(0, 1));
+        EXPECT_EQ(2, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+class CountingMemoryResource final : public MemoryResource
+{
+public:
+    void* allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        liveBytes += bytes;
+        return getNewDeleteResource()->allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        liveBytes -= bytes;
+        getNewDeleteResource()->deallocate(ptr, bytes, alignment);
+    }
+
+public:
+    size_t allocations = 0U;
+    size_t liveBytes = 0U;
+};
+
+TEST(VectorAllocatorTestSuite, testStatelessAllocatorSize)
+{
+    EXPECT_EQ(sizeof(void*), sizeof(CompactVector<int>));
+    EXPECT_EQ(sizeof(InlineVector<int, 2>), sizeof(InlineVector<int, 2, std::allocator<int>>));
+    EXPECT_EQ(2U * sizeof(void*), sizeof(pmr::CompactVector<int>));
+}
+
+template <typename T>
+class VectorAllocatorTestSuite : public ::testing::Test
+{
+};
+
+using PmrVectorTypes = ::testing::Types<pmr::CompactVector<int>, pmr::InlineVector<int, 2>, pmr::PackedInlineVector<int>>;
+TYPED_TEST_SUITE(VectorAllocatorTestSuite, PmrVectorTypes);
+
+TYPED_TEST(VectorAllocatorTestSuite, testAllocationsUseResource)
+{
+    CountingMemoryResource resource;
+    {
+        TypeParam testArray{PolymorphicAllocator<int>(&resource)};
+        for (int i = 0; i < 100; ++i)
+        {
+            testArray.push_back(i);
+        }
+        EXPECT_EQ(&resource, testArray.get_allocator().getResource());
+        EXPECT_LT(0U, resource.allocations);
+        EXPECT_LT(0U, resource.liveBytes);
+    }
+    EXPECT_EQ(0U, resource.liveBytes);
+}
+
+TYPED_TEST(VectorAllocatorTestSuite, testBulkFillAllocatesOnce)
+{
+    CountingMemoryResource resource;
+    TypeParam testArray{PolymorphicAllocator<int>(&resource)};
+    testArray.resize_default_init(100U);
+    EXPECT_EQ(100U, testArray.size());
+    EXPECT_EQ(1U, resource.allocations);
+
+    const std::vector<int> values(1000U, 1);
+    testArray.assign(values.begin(), values.end());
+    EXPECT_EQ(2U, resource.allocations);
+
+    testArray.append(values.begin(), values.end());
+    EXPECT_EQ(3U, resource.allocations);
+    EXPECT_EQ(2000U, testArray.size());
+}
+
+TYPED_TEST(VectorAllocatorTestSuite, testCopyAndMove)
+{
+    CountingMemoryResource resource;
+    {
+        TypeParam testArray({1, 2, 3, 4, 5}, PolymorphicAllocator<int>(&resource));
+        const auto allocations = resource.allocations;
+
+        TypeParam copyArray(testArray);
+        EXPECT_EQ(getNewDeleteResource(), copyArray.get_allocator().getResource());
+        EXPECT_EQ(allocations, resource.allocations);
+        EXPECT_THAT(copyArray, ElementsAre(1, 2, 3, 4, 5));
+
+        TypeParam movedArray(std::move(testArray));
+        EXPECT_EQ(&resource, movedArray.get_allocator().getResource());
+        EXPECT_THAT(movedArray, ElementsAre(1, 2, 3, 4, 5));
+
+        movedArray.reserve(100U);
+        EXPECT_LT(allocations, resource.allocations);
+
+        copyArray = movedArray;
+        EXPECT_EQ(getNewDeleteResource(), copyArray.get_allocator().getResource());
+        EXPECT_THAT(copyArray, ElementsAre(1, 2, 3, 4, 5));
+
+        copyArray.swap(movedArray);
+        EXPECT_EQ(&resource, copyArray.get_allocator().getResource());
+        EXPECT_EQ(getNewDeleteResource(), movedArray.get_allocator().getResource());
+    }
+    EXPECT_EQ(0U, resource.liveBytes);
+}
+
+// Reports 16 more elements than requested, like a size-class based allocator.
+template <typename T>
+struct HarvestingAllocator : std::allocator<T>
+{
+    static constexpr size_t Slack = 16U;
+
+    HarvestingAllocator() = default;
+
+    template <typename U>
+    HarvestingAllocator(const HarvestingAllocator<U>&)
+    {
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = HarvestingAllocator<U>;
+    };
+
+    AllocationResult<T*> allocate_at_least(size_t count)
+    {
+        return {std::allocator<T>::allocate(count + Slack), count + Slack};
+    }
+
+    // Storage may return any count between requested and reported one.
+    void deallocate(T* ptr, size_t)
+    {
+        ::operator delete(ptr);
+    }
+};
+
+// Resizes blocks in place unless failures are enabled, in which case all allocations throw.
+template <typename T>
+struct FailingAllocator : std::allocator<T>
+{
+    FailingAllocator() = default;
+
+    template <typename U>
+    FailingAllocator(const FailingAllocator<U>&)
+    {
+    }
+
+    template <typename U>
+    struct rebind
+    {
+        using other = FailingAllocator<U>;
+    };
+
+    static bool& shouldFail()
+    {
+        static bool value = false;
+        return value;
+    }
+
+    T* allocate(size_t count)
+    {
+        if (FailingAllocator<char>::shouldFail())
+        {
+            throw std::bad_alloc();
+        }
+        return std::allocator<T>::allocate(count);
+    }
+
+    AllocationResult<T*> reallocate(T* ptr, size_t oldCount, size_t newCount)
+    {
+        auto* result = allocate(newCount);
+        std::memcpy(static_cast<void*>(result), ptr, std::min(oldCount, newCount) * sizeof(T));
+        this->deallocate(ptr, oldCount);
+        return {result, newCount};
+    }
+};
+
+template <typename T>
+class VectorHarvestingTestSuite : public ::testing::Test
+{
+};
+
+using HarvestingVectorTypes = ::testing::Types<CompactVector<int, HarvestingAllocator<int>>,
+                                               InlineVector<int, 1, HarvestingAllocator<int>>,
+                                               CompactVector<int, MallocAllocator<int>>>;
+TYPED_TEST_SUITE(VectorHarvestingTestSuite, HarvestingVectorTypes);
+
+TYPED_TEST(VectorHarvestingTestSuite, testCapacityIsHarvested)
+{
+    TypeParam testArray;
+    testArray.reserve(10U);
+    const auto capacity = testArray.capacity();
+    EXPECT_LE(10U, capacity);
+
+    const auto* data = testArray.begin();
+    for (size_t i = 0U; i < capacity; ++i)
+    {
+        testArray.push_back(static_cast<int>(i));
+    }
+    EXPECT_EQ(data, testArray.begin());
+    EXPECT_EQ(capacity, testArray.capacity());
+
+    testArray.reserve(std::numeric_limits<uint16_t>::max() + 1U);
+    EXPECT_LT(std::numeric_limits<uint16_t>::max(), testArray.capacity());
+    for (size_t i = 0U; i < capacity; ++i)
+    {
+        ASSERT_EQ(static_cast<int>(i), testArray[i]);
+    }
+}
+
+TEST(VectorHarvestingTestSuite, testSlackIsUsed)
+{
+    CompactVector<int, HarvestingAllocator<int>> compactArray;
+    compactArray.reserve(10U);
+    EXPECT_LE(10U + HarvestingAllocator<int>::Slack, compactArray.capacity());
+
+    InlineVector<int, 1, HarvestingAllocator<int>> inlineArray;
+    inlineArray.reserve(10U);
+    EXPECT_EQ(10U + HarvestingAllocator<int>::Slack, inlineArray.capacity());
+}
+
+template <typename T>
+class VectorTierTestSuite : public ::testing::Test
+{
+};
+
+using VectorTierTypes = ::testing::Types<CompactVector<uint8_t>,
+                                         CompactVector<uint16_t>,
+                                         CompactVector<uint16_t, MallocAllocator<uint16_t>>,
+                                         CompactVector<uint64_t>>;
+TYPED_TEST_SUITE(VectorTierTestSuite, VectorTierTypes);
+
+TYPED_TEST(VectorTierTestSuite, testPromotionAcrossTiers)
+{
+    using ValueType = typename TypeParam::value_type;
+
+    TypeParam testArray;
+    const size_t count = std::numeric_limits<uint16_t>::max() + 10U;
+    for (size_t i = 0U; i < count; ++i)
+    {
+        testArray.push_back(static_cast<ValueType>(i));
+        ASSERT_EQ(i + 1U, testArray.size());
+        ASSERT_EQ(static_cast<ValueType>(i / 2U), testArray[i / 2U]);
+    }
+
+    testArray.insert(testArray.begin(), ValueType(7));
+    EXPECT_EQ(ValueType(7), testArray.front());
+    EXPECT_EQ(static_cast<ValueType>(count - 1U), testArray.back());
+}
+
+TEST(VectorTierTestSuite, testTinyHeaderFootprint)
+{
+    CountingMemoryResource resource;
+
+    // 2-byte tiny header + 3 * 2 bytes, where the short header would take 4 bytes and round the block up to 12.
+    pmr::CompactVector<uint16_t, ExactGrowth> smallArray{PolymorphicAllocator<uint16_t>(&resource)};
+    smallArray.reserve(3U);
+    EXPECT_EQ(8U, resource.liveBytes);
+
+    // Elements with 4-byte alignment don't benefit from tiny header and use the short one.
+    pmr::CompactVector<uint32_t, ExactGrowth> alignedArray{PolymorphicAllocator<uint32_t>(&resource)};
+    alignedArray.reserve(3U);
+    EXPECT_EQ(8U + 16U, resource.liveBytes);
+}
+
+TYPED_TEST(VectorTierTestSuite, testShrinkAcrossTiers)
+{
+    using ValueType = typename TypeParam::value_type;
+
+    TypeParam testArray;
+    for (size_t i = 0U; i < std::numeric_limits<uint16_t>::max() + 10U; ++i)
+    {
+        testArray.push_back(static_cast<ValueType>(i));
+    }
+
+    testArray.erase(testArray.begin() + 3U, testArray.end());
+    testArray.shrink_to_fit();
+    EXPECT_LE(3U, testArray.capacity());
+    EXPECT_GT(16U, testArray.capacity());
+    EXPECT_THAT(testArray, ElementsAre(0, 1, 2));
+}
+
+TEST(VectorTierTestSuite, testShrinkDowngradesHeader)
+{
+    CountingMemoryResource resource;
+    pmr::CompactVector<uint16_t, ExactGrowth> testArray{PolymorphicAllocator<uint16_t>(&resource)};
+    testArray.reserve(std::numeric_limits<uint16_t>::max() + 1U);
+    for (uint16_t i = 1U; i <= 3U; ++i)
+    {
+        testArray.push_back(i);
+    }
+
+    // Long header is replaced with the 2-byte tiny one.
+    testArray.shrink_to_fit();
+    EXPECT_EQ(8U, resource.liveBytes);
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+}
+
+template <typename T>
+class VectorFailedShrinkTestSuite : public ::testing::Test
+{
+};
+
+using FailedShrinkVectorTypes = ::testing::Types<CompactVector<uint16_t, FailingAllocator<uint16_t>, ExactGrowth>,
+                                                 TaggedVector<uint16_t, FailingAllocator<uint16_t>>>;
+TYPED_TEST_SUITE(VectorFailedShrinkTestSuite, FailedShrinkVectorTypes);
+
+// Header is replaced only after the block is resized, so a failed shrink keeps the vector intact.
+TYPED_TEST(VectorFailedShrinkTestSuite, testFailedShrinkKeepsElements)
+{
+    // Short header of CompactVector and large one of TaggedVector are replaced by smaller ones on shrink.
+    TypeParam testArray;
+    testArray.reserve(4096U);
+    for (uint16_t i = 1U; i <= 3U; ++i)
+    {
+        testArray.push_back(i);
+    }
+    const auto capacity = testArray.capacity();
+
+    FailingAllocator<char>::shouldFail() = true;
+    EXPECT_THROW(testArray.shrink_to_fit(), std::bad_alloc);
+    FailingAllocator<char>::shouldFail() = false;
+    EXPECT_EQ(capacity, testArray.capacity());
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+
+    testArray.shrink_to_fit();
+    EXPECT_GT(16U, testArray.capacity());
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+}
+
+// Huge blocks are mapped lazily by MallocAllocator, so only touched pages take memory.
+TEST(VectorTierTestSuite, testHugeCapacity)
+{
+    const size_t hugeCapacity = size_t(std::numeric_limits<uint32_t>::max()) + 16U;
+
+    CompactVector<uint8_t, MallocAllocator<uint8_t>> testArray = {1, 2, 3};
+    testArray.reserve(hugeCapacity);
+    EXPECT_LE(hugeCapacity, testArray.capacity());
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+
+    testArray.push_back(4);
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3, 4));
+
+    // Long blocks grow into huge ones in place.
+    CompactVector<uint8_t, MallocAllocator<uint8_t>> longArray;
+    longArray.reserve(size_t(1U) << 20U);
+    longArray.insert(longArray.end(), testArray.begin(), testArray.end());
+    longArray.reserve(hugeCapacity);
+    EXPECT_LE(hugeCapacity, longArray.capacity());
+    EXPECT_THAT(longArray, ElementsAre(1, 2, 3, 4));
+
+    longArray.release();
+    EXPECT_EQ(0U, longArray.capacity());
+}
+
+TEST(VectorAllocatorTestSuite, testInPlaceGrowthAcrossTiers)
+{
+    CompactVector<uint8_t, MallocAllocator<uint8_t>> testArray;
+    for (size_t i = 0U; i < 2U * MallocDetails::MmapThreshold; ++i)
+    {
+        testArray.push_back(static_cast<uint8_t>(i));
+    }
+
+    ASSERT_EQ(2U * MallocDetails::MmapThreshold, testArray.size());
+    for (size_t i = 0U; i < testArray.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<uint8_t>(i), testArray[i]);
+    }
+}
+
+TEST(VectorAllocatorTestSuite, testInlineDataDoesNotAllocate)
+{
+    CountingMemoryResource resource;
+    pmr::InlineVector<int, 2> testArray{PolymorphicAllocator<int>(&resource)};
+    testArray.push_back(1);
+    testArray.push_back(2);
+    EXPECT_EQ(0U, resource.allocations);
+
+    testArray.push_back(3);
+    EXPECT_EQ(1U, resource.allocations);
+}
+
+TEST(VectorPackedInlineTestSuite, testFootprint)
+{
+    EXPECT_EQ(24U, (sizeof(InlineVector<uint8_t, 14>)));
+    EXPECT_EQ(24U, (sizeof(PackedInlineVector<uint8_t, 24U>)));
+    EXPECT_EQ(32U, sizeof(PackedInlineVector<uint32_t>));
+    EXPECT_EQ(23U, (PackedInlineVector<uint8_t, 24U>().capacity()));
+    EXPECT_EQ(7U, PackedInlineVector<uint32_t>().capacity());
+    EXPECT_EQ(3U, PackedInlineVector<uint64_t>().capacity());
+}
+
+TEST(VectorPackedInlineTestSuite, testInlineAndHeapData)
+{
+    PackedInlineVector<uint8_t, 24U> testArray;
+    const auto* inlineData = reinterpret_cast<const uint8_t*>(&testArray);
+    for (uint8_t i = 0U; i < 23U; ++i)
+    {
+        testArray.push_back(i);
+        ASSERT_EQ(i + 1U, testArray.size());
+        ASSERT_EQ(inlineData, testArray.data());
+    }
+
+    testArray.push_back(23U);
+    EXPECT_NE(inlineData, testArray.data());
+    EXPECT_LE(24U, testArray.capacity());
+    for (uint8_t i = 0U; i < 24U; ++i)
+    {
+        ASSERT_EQ(i, testArray[i]);
+    }
+
+    testArray.resize(3U);
+    testArray.shrink_to_fit();
+    EXPECT_EQ(inlineData, testArray.data());
+    EXPECT_THAT(testArray, ElementsAre(0, 1, 2));
+}
+
+TEST(VectorStaticTestSuite, testFootprint)
+{
+    EXPECT_EQ(8U, (sizeof(StaticVector<uint8_t, 7U>)));
+    EXPECT_EQ(516U, (sizeof(StaticVector<uint16_t, 257U>)));
+    EXPECT_EQ(64U, (StaticVector<uint64_t, 64U>().capacity()));
+}
+
+TEST(VectorStaticTestSuite, testOverflow)
+{
+    StaticVector<int, 3U> testArray = {1, 2, 3};
+    EXPECT_THROW(testArray.push_back(4), std::length_error);
+    EXPECT_THROW(testArray.reserve(4U), std::length_error);
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+
+    StaticVector<int, 3U, AssertOnOverflow> assertingArray = {1, 2, 3};
+    EXPECT_DEATH(assertingArray.push_back(4), "");
+}
+
+TEST(VectorStaticTestSuite, testMutation)
+{
+    StaticVector<int, 16U> testArray = {1, 2, 3};
+    testArray.insert(testArray.begin() + 1, 5);
+    testArray.erase(testArray.begin());
+    testArray.resize(5U, 7);
+    testArray.emplace(testArray.begin(), 9);
+    EXPECT_THAT(testArray, ElementsAre(9, 5, 2, 3, 7, 7));
+
+    testArray.shrink_to_fit();
+    EXPECT_EQ(16U, testArray.capacity());
+    testArray.clear();
+    EXPECT_TRUE(testArray.empty());
+}
+
+TEST(VectorStaticTestSuite, testTryPushBack)
+{
+    StaticVector<int, 2U> testArray;
+    EXPECT_EQ(testArray.data(), testArray.try_push_back(1));
+    EXPECT_EQ(testArray.data() + 1, testArray.try_emplace_back(2));
+    EXPECT_EQ(nullptr, testArray.try_push_back(3));
+    EXPECT_THAT(testArray, ElementsAre(1, 2));
+
+    // Other vectors append only without reallocation.
+    CompactVector<int> compactArray;
+    EXPECT_EQ(nullptr, compactArray.try_push_back(1));
+    compactArray.reserve(1U);
+    EXPECT_NE(nullptr, compactArray.try_push_back(1));
+}
+
+TEST(VectorStaticTestSuite, testElementsLifetime)
+{
+    int objectsCounter = 0;
+    {
+        StaticVector<TestType, 4U> testArray;
+        testArray.emplace_back(objectsCounter);
+        testArray.emplace_back(objectsCounter);
+
+        auto copy = testArray;
+        EXPECT_EQ(4, objectsCounter);
+
+        StaticVector<TestType, 4U> moved(std::move(copy));
+        EXPECT_EQ(0U, copy.size());
+        EXPECT_EQ(2U, moved.size());
+        EXPECT_EQ(4, objectsCounter);
+
+        moved.swap(testArray);
+        moved.pop_back();
+        EXPECT_EQ(3, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+template <typename T>
+class VectorAlignmentTestSuite : public ::testing::Test
+{
+};
+
+using AlignedVectorTypes = ::testing::Types<AlignedCompactVector<uint8_t, 32U>,
+                                            AlignedCompactVector<int, 64U>,
+                                            AlignedInlineVector<float, 4U, 32U>,
+                                            AlignedInlineVector<uint8_t, 8U, 64U>>;
+TYPED_TEST_SUITE(VectorAlignmentTestSuite, AlignedVectorTypes);
+
+// Inline elements keep natural alignment, so only heap data is checked.
+template <typename T, size_t Alignment, typename Allocator, typename GrowthPolicy>
+bool isAligned(const Vector<VectorDetails::MemoryOptimizedStorage<T, Allocator, Alignment>, GrowthPolicy>& vector)
+{
+    return reinterpret_cast<uintptr_t>(vector.data()) % Alignment == 0U;
+}
+
+template <typename T, uint32_t InlineSize, size_t Alignment, typename Allocator, typename GrowthPolicy>
+bool isAligned(const Vector<VectorDetails::InlineStorage<T, InlineSize, Allocator, Alignment>, GrowthPolicy>& vector)
+{
+    return vector.capacity() <= InlineSize || reinterpret_cast<uintptr_t>(vector.data()) % Alignment == 0U;
+}
+
+TYPED_TEST(VectorAlignmentTestSuite, testDataIsAligned)
+{
+    using T = typename TypeParam::value_type;
+
+    TypeParam testArray;
+    for (size_t i = 0U; i < 1000U; ++i)
+    {
+        testArray.push_back(static_cast<T>(i));
+        ASSERT_TRUE(isAligned(testArray)) << i;
+    }
+
+    testArray.reserve(100000U);
+    EXPECT_TRUE(isAligned(testArray));
+    testArray.shrink_to_fit();
+    EXPECT_TRUE(isAligned(testArray));
+
+    const auto copy = testArray;
+    EXPECT_TRUE(isAligned(copy));
+    EXPECT_EQ(testArray, copy);
+    for (size_t i = 0U; i < testArray.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<T>(i), testArray[i]);
+    }
+
+    testArray.resize(2U);
+    testArray.shrink_to_fit();
+    EXPECT_TRUE(isAligned(testArray));
+    EXPECT_EQ(static_cast<T>(1), testArray[1]);
+}
+
+TEST(VectorAlignmentTestSuite, testAlignedAllocator)
+{
+    AlignedAllocator<char, 128U> allocator;
+    char* ptr = allocator.allocate(3U);
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(ptr) % 128U);
+    allocator.deallocate(ptr, 3U);
+    EXPECT_TRUE((allocator == AlignedAllocator<int, 128U>()));
+}
+
+TEST(VectorAlignmentTestSuite, testPolymorphicAllocator)
+{
+    CountingMemoryResource resource;
+    {
+        AlignedCompactVector<int, 64U, PolymorphicAllocator<int>> testArray{PolymorphicAllocator<int>(&resource)};
+        for (int i = 0; i < 100; ++i)
+        {
+            testArray.push_back(i);
+            ASSERT_EQ(0U, reinterpret_cast<uintptr_t>(testArray.data()) % 64U);
+        }
+        EXPECT_LT(0U, resource.allocations);
+    }
+    EXPECT_EQ(0U, resource.liveBytes);
+}
+
+TEST(VectorSharedTestSuite, testFootprint)
+{
+    EXPECT_EQ(sizeof(void*), sizeof(SharedCompactVector<int>));
+}
+
+TEST(VectorSharedTestSuite, testCopiesShareElements)
+{
+    SharedCompactVector<int> testArray = {1, 2, 3};
+    EXPECT_TRUE(testArray.unique());
+
+    const auto copy = testArray;
+    EXPECT_FALSE(testArray.unique());
+    EXPECT_FALSE(copy.unique());
+    EXPECT_EQ(static_cast<const SharedCompactVector<int>&>(testArray).data(), copy.data());
+
+    SharedCompactVector<int> assigned;
+    assigned = copy;
+    EXPECT_EQ(copy.data(), static_cast<const SharedCompactVector<int>&>(assigned).data());
+    EXPECT_EQ(copy, assigned);
+}
+
+TEST(VectorSharedTestSuite, testMutationDetaches)
+{
+    SharedCompactVector<int> testArray = {1, 2, 3};
+    auto copy = testArray;
+    auto other = testArray;
+
+    copy[1] = 20;
+    EXPECT_TRUE(copy.unique());
+    EXPECT_THAT(copy, ElementsAre(1, 20, 3));
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+    EXPECT_FALSE(testArray.unique());
+
+    other.push_back(4);
+    other.pop_back();
+    other.pop_back();
+    EXPECT_THAT(other, ElementsAre(1, 2));
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+    EXPECT_TRUE(testArray.unique());
+
+    auto resized = testArray;
+    resized.resize_default_init(5U);
+    EXPECT_EQ(5U, resized.size());
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+
+    // Positions taken from the shared block are kept.
+    auto erased = testArray;
+    const auto& constErased = erased;
+    erased.erase(constErased.begin() + 1);
+    erased.insert(constErased.begin(), 0);
+    EXPECT_THAT(erased, ElementsAre(0, 1, 3));
+    EXPECT_THAT(testArray, ElementsAre(1, 2, 3));
+
+    auto shrunk = testArray;
+    shrunk.reserve(100U);
+    shrunk.shrink_to_fit();
+    EXPECT_THAT(shrunk, ElementsAre(1, 2, 3));
+    EXPECT_NE(static_cast<const SharedCompactVector<int>&>(testArray).data(), shrunk.data());
+}
+
+TEST(VectorSharedTestSuite, testMakeUniqueStorage)
+{
+    int copies = 0;
+    SharedCompactVector<CopyCountingType> testArray;
+    testArray.reserve(10U);
+    for (int i = 0; i < 10; ++i)
+    {
+        testArray.push_back(CopyCountingType(i, copies));
+    }
+    copies = 0;
+
+    auto copy = testArray;
+    EXPECT_EQ(0, copies);
+
+    copy.make_unique_storage();
+    EXPECT_EQ(10, copies);
+    EXPECT_TRUE(copy.unique());
+    EXPECT_TRUE(testArray.unique());
+
+    // Unique elements aren't copied again.
+    const auto* data = copy.data();
+    for (auto& item : copy)
+    {
+        item.value *= 2;
+    }
+    EXPECT_EQ(10, copies);
+    EXPECT_EQ(data, copy.data());
+    EXPECT_EQ(18, copy.back().value);
+    EXPECT_EQ(9, testArray.back().value);
+}
+
+// Shared elements are copied only when they're kept and straight into the requested capacity.
+TEST(VectorSharedTestSuite, testClearAndReserveDontCopyTwice)
+{
+    int copies = 0;
+    SharedCompactVector<CopyCountingType> testArray;
+    for (int i = 0; i < 10; ++i)
+    {
+        testArray.push_back(CopyCountingType(i, copies));
+    }
+    copies = 0;
+
+    auto cleared = testArray;
+    cleared.clear();
+    EXPECT_EQ(0, copies);
+    EXPECT_TRUE(cleared.empty());
+    EXPECT_TRUE(testArray.unique());
+    EXPECT_EQ(10U, testArray.size());
+
+    auto reserved = testArray;
+    reserved.reserve(100U);
+    EXPECT_EQ(10, copies);
+    EXPECT_LE(100U, reserved.capacity());
+    EXPECT_TRUE(testArray.unique());
+    EXPECT_EQ(9, reserved.back().value);
+}
+
+TEST(VectorSharedTestSuite, testLifetime)
+{
+    int objectsCounter = 0;
+    {
+        SharedCompactVector<TestType> testArray;
+        for (int i = 0; i < 10; ++i)
+        {
+            testArray.push_back(TestType(objectsCounter));
+        }
+        // Flags elements without non-const access, which would make the block unshareable.
+        const auto setCopyThrows = [&testArray](const bool value) {
+            const auto& constArray = testArray;
+            const_cast<TestType&>(constArray[0]).shouldCopyCtorThrow = value;
+        };
+
+        // Failed copy leaves elements shared.
+        setCopyThrows(true);
+        auto failed = testArray;
+        EXPECT_THROW(failed.make_unique_storage(), std::runtime_error);
+        EXPECT_FALSE(failed.unique());
+        EXPECT_EQ(10, objectsCounter);
+        failed.release();
+        EXPECT_TRUE(testArray.unique());
+        EXPECT_EQ(10, objectsCounter);
+
+        setCopyThrows(false);
+        auto copy = testArray;
+        EXPECT_EQ(10, objectsCounter);
+        copy.pop_back();
+        EXPECT_EQ(19, objectsCounter);
+
+        testArray.clear();
+        EXPECT_EQ(9, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+// Copies don't see writes through references, which were taken before the copy.
+TEST(VectorSharedTestSuite, testReferencesTakenBeforeCopy)
+{
+    SharedCompactVector<int> testArray = {1, 2, 3};
+    auto& first = testArray[0];
+    auto it = testArray.begin() + 1;
+
+    const auto copy = testArray;
+    EXPECT_TRUE(testArray.unique());
+    EXPECT_TRUE(copy.unique());
+    first = 10;
+    *it = 20;
+    EXPECT_THAT(testArray, ElementsAre(10, 20, 3));
+    EXPECT_THAT(copy, ElementsAre(1, 2, 3));
+
+    // Changes handing out no references don't make the block unshareable.
+    SharedCompactVector<int> other;
+    other.reserve(4U);
+    other.push_back(1);
+    other.resize(3U);
+    other.pop_back();
+    const auto otherCopy = other;
+    EXPECT_FALSE(other.unique());
+    EXPECT_EQ(static_cast<const SharedCompactVector<int>&>(other).data(), otherCopy.data());
+
+    // Copy of an unshareable block fails as a whole.
+    int objectsCounter = 0;
+    {
+        SharedCompactVector<TestType> throwing;
+        throwing.push_back(TestType(objectsCounter));
+        throwing.push_back(TestType(objectsCounter));
+        throwing[1].shouldCopyCtorThrow = true;
+        EXPECT_THROW(auto failed = throwing, std::runtime_error);
+        EXPECT_EQ(2, objectsCounter);
+
+        throwing[1].shouldCopyCtorThrow = false;
+        auto copied = throwing;
+        EXPECT_EQ(4, objectsCounter);
+    }
+    EXPECT_EQ(0, objectsCounter);
+}
+
+TEST(VectorSharedTestSuite, testCopiesInThreads)
+{
+    SharedCompactVector<std::string> testArray;
+    for (int i = 0; i < 100; ++i)
+    {
+        testArray.push_back("long enough string to be allocated #" + std::to_string(i));
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 0U; thread < 4U; ++thread)
+    {
+        threads.emplace_back([&testArray, thread] {
+            for (size_t i = 0U; i < 1000U; ++i)
+            {
+                auto copy = testArray;
+                if (i % 10U == thread)
+                {
+                    copy.pop_back();
+                    EXPECT_EQ(99U, copy.size());
+                }
+                EXPECT_EQ("long enough string to be allocated #0", copy.front());
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_TRUE(testArray.unique());
+    EXPECT_EQ(100U, testArray.size());
+}
+
+TEST(VectorSharedTestSuite, testPolymorphicAllocator)
+{
+    CountingMemoryResource resource;
+    {
+        pmr::SharedCompactVector<int> testArray({1, 2, 3}, PolymorphicAllocator<int>(&resource));
+        const auto allocations = resource.allocations;
+
+        // Copies share the block and its allocator.
+        auto copy = testArray;
+        EXPECT_EQ(&resource, copy.get_allocator().getResource());
+        EXPECT_EQ(allocations, resource.allocations);
+
+        copy.push_back(4);
+        EXPECT_LT(allocations, resource.allocations);
+        EXPECT_THAT(copy, ElementsAre(1, 2, 3, 4));
+    }
+    EXPECT_EQ(0U, resource.liveBytes);
+}
+
 } // namespace UT
 } // namespace SCONE